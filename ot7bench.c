@@ -0,0 +1,1038 @@
+/* https://github.com/otseven/OT7
+
+--------------------------------------------------------------------------------
+ot7bench.c - BENCHMARK PROGRAM FOR OT7 ENCRYPTION TOOL          October 16, 2026
+--------------------------------------------------------------------------------
+
+PURPOSE: To measure the speed of the OT7 encryption tool.
+
+DESCRIPTION: This is a separate program that measures how fast the routines
+in OT7.c run. Unlike ot7test, which runs the ot7 tool with system(), this
+program includes OT7.c so that its routines can be called and timed directly.
+
+These routines are measured:
+
+    Skein1024_Update()           Hashing message data.
+    Skein1024_Final()            Making pseudo-random key bytes.
+    XorBytes()                   Combining key bytes with data bytes.
+    WriteBytesX(), ReadBytesX()  Writing and reading base64 files.
+    InterleaveTextFillBytes(),
+    DeinterleaveTextFillBytes()  Mixing fill bytes with text bytes.
+
+Then whole encryption and decryption runs of the ot7 tool are measured for
+plaintext files from 1KB up to a maximum size, by default 64MB. Use the '-max'
+option to measure larger files, up to 10GB or more.
+
+Speeds are reported in megabytes per second and, on x86 processors, in time
+stamp counter cycles per byte.
+
+To build ot7bench:   gcc -O2 ot7bench.c -o ot7bench
+
+USAGE: ot7bench [-csv | -json] [-max <# of bytes>] [-mb <# of megabytes>]
+
+    -csv     Print the results as comma-separated values.
+
+    -json    Print the results as a JSON object.
+
+    -max     Largest plaintext file to encrypt and decrypt. The size may end
+             with K, M or G for kilobytes, megabytes or gigabytes.
+
+    -mb      Megabytes of data processed when timing each routine, by default
+             64.
+
+Working files are made in a directory named 'ot7bench.tmp' which is deleted
+when the benchmark is done. The disk space required is about four times the
+'-max' size.
+
+The benchmark ends early with an error message if any error is detected.
+
+------------------------------------------------------------------------------*/
+
+// Rename the main() routine of the ot7 tool so that it can be called from
+// this program.
+#define main OT7Main
+
+#include "OT7.c"
+
+#undef main
+
+// For the wall clock timer and working directory routines...
+#if defined( _MSC_VER )
+    #include <direct.h>
+    #define chdir   _chdir
+    #define rmdir   _rmdir
+#else
+    #include <sys/time.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif // _MSC_VER
+
+#define BENCHMARK_BUFFER_SIZE  (64*1024)
+            // Size of the data buffer passed to each routine being measured.
+
+#define BENCHMARK_WORKING_DIRECTORY "ot7bench.tmp"
+            // Name of the directory where working files are made.
+
+#define DEFAULT_MAX_FILE_SIZE  (64LL*1024*1024)
+            // Default size of the largest plaintext file to be encrypted.
+
+#define DEFAULT_ROUTINE_MEGABYTES  64
+            // Default number of megabytes processed when timing each routine.
+
+#define KEY_FILE_MARGIN  (1024*1024)
+            // Number of bytes added to the largest plaintext file size to make
+            // the size of the key file. This leaves room for the key bytes used
+            // to encrypt the header of each OT7 record.
+
+#define MAX_BENCHMARK_RESULTS  256
+            // Maximum number of measurements that can be reported.
+
+#define MAX_WHOLE_RUN_COUNT  64
+            // Maximum number of times a small file is encrypted and decrypted
+            // to get a stable measurement.
+
+#define WHOLE_RUN_BYTE_COUNT  (16LL*1024*1024)
+            // Number of plaintext bytes to process when measuring the whole
+            // encryption and decryption of small files.
+
+// Output formats for the results.
+#define BENCHMARK_OUTPUT_TEXT  0
+#define BENCHMARK_OUTPUT_CSV   1
+#define BENCHMARK_OUTPUT_JSON  2
+
+/*------------------------------------------------------------------------------
+| BenchmarkResult
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To hold one measurement made by the benchmark.
+|
+| HISTORY:
+|    16Oct26
+------------------------------------------------------------------------------*/
+typedef struct
+{
+    s8* TestName;
+            // Name of the routine or operation that was measured.
+            //
+    u64 Size;
+            // Number of bytes passed to the routine on each call, or the size
+            // of the plaintext file for whole encryption and decryption runs.
+            //
+    u64 TotalBytes;
+            // Total number of bytes processed during the measurement.
+            //
+    double Seconds;
+            // Elapsed wall clock time of the measurement in seconds.
+            //
+    u64 Cycles;
+            // Elapsed cycle counter ticks, or 0 if there is no cycle counter.
+} BenchmarkResult;
+
+//------------------------------------------------------------------------------
+
+u8 BenchmarkBufferA[BENCHMARK_BUFFER_SIZE];
+u8 BenchmarkBufferB[BENCHMARK_BUFFER_SIZE];
+            // Data buffers passed to the routines being measured.
+
+OT7Context BenchmarkContext;
+            // Context record used for measuring InterleaveTextFillBytes() and
+            // DeinterleaveTextFillBytes(). The text and TextFill bytes are kept
+            // in the benchmark data buffers.
+
+u64 BenchmarkRandomState = 0x9E3779B97F4A7C15LL;
+            // State of the pseudo-random generator used to make test files.
+            // The content of the test files doesn't matter for measuring
+            // speed, so a fast xorshift generator is used.
+
+BenchmarkResult BenchmarkResults[MAX_BENCHMARK_RESULTS];
+u32 BenchmarkResultCount = 0;
+            // The measurements made so far.
+
+u64 MeasurementStartCycles;
+double MeasurementStartSeconds;
+            // Cycle counter and wall clock time at the start of the current
+            // measurement.
+
+u32 OutputFormat = BENCHMARK_OUTPUT_TEXT;
+            // Format used to print the results.
+
+//------------------------------------------------------------------------------
+
+void    EndMeasurement( s8* TestName, u64 Size, u64 TotalBytes );
+void    ExitOnBenchmarkError( s8* Message, int ResultCode );
+u32     GenerateBenchmarkFile( s8* FileName, u64 FileSize );
+u32     IsBenchmarkFilesIdentical( s8* AFileName, s8* BFileName );
+void    MeasureEncryptDecrypt( u64 FileSize, u32 IsBinaryFormat );
+void    MeasureRoutines( u64 ByteCount );
+u64     ParseSizeString( s8* S );
+void    PrintBenchmarkResults();
+double  ReadWallClockSeconds();
+void    StartMeasurement();
+
+/*------------------------------------------------------------------------------
+| main
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To measure the speed of the OT7 routines and print the results.
+|
+| DESCRIPTION: See the description at the top of this file.
+|
+| HISTORY:
+|    16Oct26
+------------------------------------------------------------------------------*/
+    // OUT: Result code RESULT_OK if successful, or an error code if not.
+int //
+main( int argc, char* argv[] )
+{
+    int i;
+    u64 MaxFileSize;
+    u64 RoutineMegabytes;
+    u64 FileSize;
+
+    // Use the default sizes unless they are given on the command line.
+    MaxFileSize = DEFAULT_MAX_FILE_SIZE;
+    RoutineMegabytes = DEFAULT_ROUTINE_MEGABYTES;
+
+    // Parse the command line options.
+    for( i = 1; i < argc; i++ )
+    {
+        // If the results should be printed as comma-separated values, then
+        // select that format.
+        if( IsPrefixForString( "-csv", argv[i] ) )
+        {
+            OutputFormat = BENCHMARK_OUTPUT_CSV;
+        }
+        // If the results should be printed as JSON, then select that format.
+        else if( IsPrefixForString( "-json", argv[i] ) )
+        {
+            OutputFormat = BENCHMARK_OUTPUT_JSON;
+        }
+        // If the largest file size is given, then parse it.
+        else if( IsPrefixForString( "-max", argv[i] ) && (i+1 < argc) )
+        {
+            MaxFileSize = ParseSizeString( argv[++i] );
+        }
+        // If the amount of data for timing routines is given, then parse it.
+        else if( IsPrefixForString( "-mb", argv[i] ) && (i+1 < argc) )
+        {
+            RoutineMegabytes = ParseSizeString( argv[++i] );
+        }
+        else // The option isn't known, so print the usage and exit.
+        {
+            printf( "Usage: ot7bench [-csv | -json] [-max <# of bytes>] "
+                    "[-mb <# of megabytes>]\n" );
+
+            return( RESULT_INVALID_COMMAND_LINE_PARAMETER );
+        }
+    }
+
+    // Keep the sizes large enough to measure.
+    if( MaxFileSize < 1024 )
+    {
+        MaxFileSize = 1024;
+    }
+
+    if( RoutineMegabytes == 0 )
+    {
+        RoutineMegabytes = 1;
+    }
+
+    // Initialize the OT7 application, which also selects the fastest hash
+    // routines that work on this processor.
+    InitializeApplication();
+
+    // Disable status messages from the OT7 routines.
+    IsVerbose.Value = 0;
+
+    // Make a working directory for the benchmark files and change to it. Any
+    // log or 'key.map' file in the current directory is left alone.
+#if defined( _MSC_VER )
+    _mkdir( BENCHMARK_WORKING_DIRECTORY );
+#else
+    mkdir( BENCHMARK_WORKING_DIRECTORY, 0700 );
+#endif // _MSC_VER
+
+    if( chdir( BENCHMARK_WORKING_DIRECTORY ) != 0 )
+    {
+        ExitOnBenchmarkError( "Can't change to the working directory.",
+                              RESULT_CANT_OPEN_FILE_FOR_WRITING );
+    }
+
+    // Measure the routines that do most of the work of encryption.
+    MeasureRoutines( RoutineMegabytes * 1024 * 1024 );
+
+    fprintf( stderr, "Generating a %s byte key file.\n",
+             ConvertIntegerToString64( MaxFileSize + KEY_FILE_MARGIN ) );
+
+    // Make a key file large enough to encrypt the largest plaintext file.
+    if( GenerateBenchmarkFile( "bench.key", MaxFileSize + KEY_FILE_MARGIN )
+        != RESULT_OK )
+    {
+        ExitOnBenchmarkError( "Can't make the key file.",
+                              RESULT_CANT_WRITE_KEY_FILE );
+    }
+
+    // Measure whole encryption and decryption runs for file sizes that grow
+    // by a factor of four up to the maximum size.
+    for( FileSize = 1024; ; FileSize *= 4 )
+    {
+        // Limit the last file size to the maximum size.
+        if( FileSize > MaxFileSize )
+        {
+            FileSize = MaxFileSize;
+        }
+
+        // Measure the file size in both encrypted file formats.
+        MeasureEncryptDecrypt( FileSize, 0 );
+        MeasureEncryptDecrypt( FileSize, 1 );
+
+        // Stop after the largest file.
+        if( FileSize == MaxFileSize )
+        {
+            break;
+        }
+    }
+
+    // Delete the working files and directory.
+    remove( "bench.key" );
+    remove( DEFAULT_LOG_FILE_NAME );
+    remove( DEFAULT_KEY_USAGE_LOG_FILE_NAME );
+
+    if( chdir( ".." ) == 0 )
+    {
+        rmdir( BENCHMARK_WORKING_DIRECTORY );
+    }
+
+    // Print the results in the selected format.
+    PrintBenchmarkResults();
+
+    // Clear the working memory of the OT7 routines.
+    ZeroAndFreeAllBuffers();
+
+    // Return RESULT_OK.
+    return( RESULT_OK );
+}
+
+/*------------------------------------------------------------------------------
+| EndMeasurement
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To finish a measurement started with StartMeasurement() and save
+|          the result.
+|
+| HISTORY:
+|    16Oct26
+------------------------------------------------------------------------------*/
+void
+EndMeasurement(
+    s8* TestName,
+            // Name of the routine or operation that was measured.
+            //
+    u64 Size,
+            // Number of bytes processed per call or the size of the file.
+            //
+    u64 TotalBytes )
+            // Total number of bytes processed.
+{
+    BenchmarkResult* R;
+
+    // If the table of results is full, then drop the measurement.
+    if( BenchmarkResultCount >= MAX_BENCHMARK_RESULTS )
+    {
+        return;
+    }
+
+    // Refer to the next free entry in the table of results.
+    R = &BenchmarkResults[BenchmarkResultCount++];
+
+    // Save the elapsed time and cycle count.
+    R->Seconds = ReadWallClockSeconds() - MeasurementStartSeconds;
+    R->Cycles  = ReadCycleCounter() - MeasurementStartCycles;
+
+    // Save the description of the measurement.
+    R->TestName   = TestName;
+    R->Size       = Size;
+    R->TotalBytes = TotalBytes;
+
+    // Report progress on the error stream so that the results can be
+    // redirected to a file.
+    fprintf( stderr, "Measured %s for %s bytes.\n",
+             TestName, ConvertIntegerToString64( Size ) );
+}
+
+/*------------------------------------------------------------------------------
+| ExitOnBenchmarkError
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To end the benchmark early when an error is detected.
+|
+| HISTORY:
+|    16Oct26
+------------------------------------------------------------------------------*/
+void
+ExitOnBenchmarkError( s8* Message, int ResultCode )
+{
+    printf( "ERROR: %s\n", Message );
+
+    printf( "Exiting OT7 benchmark program with result code %d = %s.\n",
+            ResultCode,
+            LookUpResultCodeString( ResultCode ) );
+
+    printf( "ENDING BENCHMARK EARLY ON FIRST FAILURE.\n" );
+
+    // Clear the working memory of the OT7 routines.
+    ZeroAndFreeAllBuffers();
+
+    // Exit from this application, returning the result code.
+    exit( ResultCode );
+}
+
+/*------------------------------------------------------------------------------
+| GenerateBenchmarkFile
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To make a file of a given size filled with pseudo-random bytes.
+|
+| HISTORY:
+|    16Oct26
+------------------------------------------------------------------------------*/
+    // OUT: Result code RESULT_OK if successful, or an error code if not.
+u32 //
+GenerateBenchmarkFile( s8* FileName, u64 FileSize )
+{
+    FILE* F;
+    u64 i;
+    u64 n;
+
+    // Open the file for writing.
+    F = fopen64( FileName, "wb" );
+
+    // If unable to open the file, then return an error code.
+    if( F == 0 )
+    {
+        return( RESULT_CANT_OPEN_FILE_FOR_WRITING );
+    }
+
+    // Write the file one buffer at a time.
+    while( FileSize )
+    {
+        // Fill the buffer with xorshift pseudo-random bytes, eight at a time.
+        for( i = 0; i < BENCHMARK_BUFFER_SIZE; i += 8 )
+        {
+            BenchmarkRandomState ^= BenchmarkRandomState << 13;
+            BenchmarkRandomState ^= BenchmarkRandomState >> 7;
+            BenchmarkRandomState ^= BenchmarkRandomState << 17;
+
+            Put_u64_LSB_to_MSB( BenchmarkRandomState, &BenchmarkBufferA[i] );
+        }
+
+        // Write a whole buffer or the bytes that remain.
+        n = FileSize < BENCHMARK_BUFFER_SIZE ? FileSize : BENCHMARK_BUFFER_SIZE;
+
+        // If unable to write the bytes, then return an error code.
+        if( fwrite( BenchmarkBufferA, 1, (size_t) n, F ) != n )
+        {
+            fclose( F );
+
+            return( RESULT_CANT_WRITE_FILE );
+        }
+
+        // Account for the bytes written.
+        FileSize -= n;
+    }
+
+    // Close the file.
+    if( fclose( F ) != 0 )
+    {
+        return( RESULT_CANT_CLOSE_FILE );
+    }
+
+    // Return RESULT_OK.
+    return( RESULT_OK );
+}
+
+/*------------------------------------------------------------------------------
+| IsBenchmarkFilesIdentical
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test if two files have the same content.
+|
+| HISTORY:
+|    16Oct26
+------------------------------------------------------------------------------*/
+    // OUT: 1 if the files are identical, or 0 if not.
+u32 //
+IsBenchmarkFilesIdentical( s8* AFileName, s8* BFileName )
+{
+    FILE* A;
+    FILE* B;
+    size_t ACount;
+    size_t BCount;
+    u32 IsIdentical;
+
+    // Open both files.
+    A = fopen64( AFileName, "rb" );
+    B = fopen64( BFileName, "rb" );
+
+    // Assume the files don't match until all the bytes have been compared.
+    IsIdentical = 0;
+
+    // If both files were opened, then compare them a buffer at a time.
+    if( A && B )
+    {
+        do
+        {
+            ACount = fread( BenchmarkBufferA, 1, BENCHMARK_BUFFER_SIZE, A );
+            BCount = fread( BenchmarkBufferB, 1, BENCHMARK_BUFFER_SIZE, B );
+
+            // If the buffers differ, then stop comparing.
+            if( ACount != BCount ||
+                memcmp( BenchmarkBufferA, BenchmarkBufferB, ACount ) )
+            {
+                break;
+            }
+
+            // If the end of both files was reached, then they match.
+            if( ACount == 0 )
+            {
+                IsIdentical = 1;
+            }
+
+        } while( ACount );
+    }
+
+    // Close the files that were opened.
+    if( A )
+    {
+        fclose( A );
+    }
+
+    if( B )
+    {
+        fclose( B );
+    }
+
+    // Return 1 if the files are identical, or 0 if not.
+    return( IsIdentical );
+}
+
+/*------------------------------------------------------------------------------
+| MeasureEncryptDecrypt
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To measure how long the ot7 tool takes to encrypt and decrypt a file
+|          of a given size.
+|
+| DESCRIPTION: The main routine of the ot7 tool is called with the same command
+| line options that a user would give, so the measurement includes everything
+| done by EncryptFileUsingKeyFile() and DecryptFileUsingKeyFile() including the
+| file I/O.
+|
+| Small files are encrypted several times to make the measurement more stable.
+|
+| The log files 'ot7.log' and 'ot7.log.bin' are deleted before each 
+| encryption so that each run starts at the beginning of the key file.
+|
+| HISTORY:
+|    16Oct26
+------------------------------------------------------------------------------*/
+void
+MeasureEncryptDecrypt(
+    u64 FileSize,
+            // Size of the plaintext file in bytes.
+            //
+    u32 IsBinaryFormat )
+            // 1 to use the binary encrypted file format, or 0 for base64.
+{
+    u32 i;
+    u32 RunCount;
+    int ResultCode;
+
+    // Command lines for encrypting and decrypting the plaintext file.
+    s8* EncryptCommand[] =
+    {
+        "ot7", "-e", "plain.bin", "-keyfile", "bench.key", "-oe",
+        "encrypted.bin", "-f", "0", "-silent", "-binary", 0
+    };
+
+    s8* DecryptCommand[] =
+    {
+        "ot7", "-d", "encrypted.bin", "-keyfile", "bench.key", "-od",
+        "decrypted.bin", "-silent", 0
+    };
+
+    // Make the plaintext file.
+    if( GenerateBenchmarkFile( "plain.bin", FileSize ) != RESULT_OK )
+    {
+        ExitOnBenchmarkError( "Can't make the plaintext file.",
+                              RESULT_CANT_WRITE_PLAINTEXT_FILE );
+    }
+
+    // Repeat small files enough times to process WHOLE_RUN_BYTE_COUNT bytes.
+    RunCount = (u32) ( WHOLE_RUN_BYTE_COUNT / FileSize );
+
+    // Run at least once and not more than MAX_WHOLE_RUN_COUNT times.
+    if( RunCount < 1 )
+    {
+        RunCount = 1;
+    }
+
+    if( RunCount > MAX_WHOLE_RUN_COUNT )
+    {
+        RunCount = MAX_WHOLE_RUN_COUNT;
+    }
+
+    // Measure encrypting the plaintext file.
+    StartMeasurement();
+
+    for( i = 0; i < RunCount; i++ )
+    {
+        // Start at the beginning of the key file and replace any earlier
+        // encrypted file.
+        remove( DEFAULT_LOG_FILE_NAME );
+        remove( DEFAULT_KEY_USAGE_LOG_FILE_NAME );
+        remove( "encrypted.bin" );
+
+        // Encrypt the plaintext file, leaving off the '-binary' option for
+        // base64 format.
+        ResultCode = OT7Main( IsBinaryFormat ? 11 : 10, EncryptCommand );
+
+        // If an error occurred, then end the benchmark.
+        if( ResultCode != RESULT_OK )
+        {
+            ExitOnBenchmarkError( "Unable to encrypt the plaintext file.",
+                                  ResultCode );
+        }
+    }
+
+    EndMeasurement( IsBinaryFormat ? "encrypt binary" : "encrypt base64",
+                    FileSize, FileSize * RunCount );
+
+    // Measure decrypting the encrypted file.
+    StartMeasurement();
+
+    for( i = 0; i < RunCount; i++ )
+    {
+        // Replace any earlier decrypted file.
+        remove( "decrypted.bin" );
+
+        // Decrypt the encrypted file.
+        ResultCode = OT7Main( 8, DecryptCommand );
+
+        // If an error occurred, then end the benchmark.
+        if( ResultCode != RESULT_OK )
+        {
+            ExitOnBenchmarkError( "Unable to decrypt the encrypted file.",
+                                  ResultCode );
+        }
+    }
+
+    EndMeasurement( IsBinaryFormat ? "decrypt binary" : "decrypt base64",
+                    FileSize, FileSize * RunCount );
+
+    // Make sure that the speed being measured is that of working code.
+    if( IsBenchmarkFilesIdentical( "plain.bin", "decrypted.bin" ) == 0 )
+    {
+        ExitOnBenchmarkError( "Decrypted file does not match the plaintext.",
+                              RESULT_INVALID_DECRYPTION_OUTPUT );
+    }
+
+    // Delete the working files.
+    remove( "plain.bin" );
+    remove( "encrypted.bin" );
+    remove( "decrypted.bin" );
+}
+
+/*------------------------------------------------------------------------------
+| MeasureRoutines
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To measure the speed of the OT7 routines that do most of the work of
+|          encryption and decryption.
+|
+| DESCRIPTION: Each routine is called repeatedly with a data buffer until the
+| given number of bytes has been processed.
+|
+| HISTORY:
+|    16Oct26
+------------------------------------------------------------------------------*/
+void
+MeasureRoutines( u64 ByteCount )
+{
+    u64 i;
+    u64 n;
+    FILEX F;
+    Skein1024Context HashContext;
+    OT7Context* c;
+
+    // Fill the data buffers with a pattern of byte values.
+    for( i = 0; i < BENCHMARK_BUFFER_SIZE; i++ )
+    {
+        BenchmarkBufferA[i] = (u8) ( i * 7 + 3 );
+        BenchmarkBufferB[i] = (u8) ( i * 13 + 5 );
+    }
+
+    //--------------------------------------------------------------------------
+    // Hash message data.
+
+    Skein1024_Init( &HashContext, KEY_BUFFER_BIT_COUNT );
+
+    StartMeasurement();
+
+    for( i = 0; i < ByteCount; i += BENCHMARK_BUFFER_SIZE )
+    {
+        Skein1024_Update( &HashContext, BenchmarkBufferA, BENCHMARK_BUFFER_SIZE );
+    }
+
+    EndMeasurement( "Skein1024_Update", BENCHMARK_BUFFER_SIZE, i );
+
+    //--------------------------------------------------------------------------
+    // Make pseudo-random key bytes the way GetBytesFromPasswordHashStream()
+    // does.
+
+    StartMeasurement();
+
+    for( i = 0; i < ByteCount; i += KEY_BUFFER_SIZE )
+    {
+        Skein1024_Final( &HashContext, BenchmarkBufferB );
+    }
+
+    EndMeasurement( "Skein1024_Final", KEY_BUFFER_SIZE, i );
+
+    // Clear the hash context.
+    ZeroBytes( (u8*) &HashContext, sizeof(HashContext) );
+
+    //--------------------------------------------------------------------------
+    // Combine key bytes with data bytes.
+
+    StartMeasurement();
+
+    for( i = 0; i < ByteCount; i += BENCHMARK_BUFFER_SIZE )
+    {
+        XorBytes( BenchmarkBufferA, BenchmarkBufferB, BENCHMARK_BUFFER_SIZE );
+    }
+
+    EndMeasurement( "XorBytes", BENCHMARK_BUFFER_SIZE, i );
+
+    //--------------------------------------------------------------------------
+    // Write a base64 file, including the time to open and close it.
+
+    StartMeasurement();
+
+    if( OpenFileX( &F, "base64.txt", OT7_FILE_FORMAT_BASE64, "wb" ) == 0 )
+    {
+        ExitOnBenchmarkError( "Can't open the base64 file for writing.",
+                              RESULT_CANT_OPEN_ENCRYPTED_FILE_FOR_WRITING );
+    }
+
+    for( i = 0; i < ByteCount; i += n )
+    {
+        n = WriteBytesX( &F, BenchmarkBufferA, BENCHMARK_BUFFER_SIZE );
+
+        if( n != BENCHMARK_BUFFER_SIZE )
+        {
+            ExitOnBenchmarkError( "Can't write the base64 file.",
+                                  RESULT_CANT_WRITE_ENCRYPTED_FILE );
+        }
+    }
+
+    if( CloseFileAfterWritingX( &F ) != 0 )
+    {
+        ExitOnBenchmarkError( "Can't close the base64 file.",
+                              RESULT_CANT_CLOSE_ENCRYPTED_FILE );
+    }
+
+    EndMeasurement( "WriteBytesX base64", BENCHMARK_BUFFER_SIZE, i );
+
+    //--------------------------------------------------------------------------
+    // Read the base64 file back.
+
+    StartMeasurement();
+
+    if( OpenFileX( &F, "base64.txt", OT7_FILE_FORMAT_BASE64, "rb" ) == 0 )
+    {
+        ExitOnBenchmarkError( "Can't open the base64 file for reading.",
+                              RESULT_CANT_OPEN_ENCRYPTED_FILE_FOR_READING );
+    }
+
+    for( i = 0; i < ByteCount; i += n )
+    {
+        n = ReadBytesX( &F, BenchmarkBufferB, BENCHMARK_BUFFER_SIZE );
+
+        if( n != BENCHMARK_BUFFER_SIZE )
+        {
+            ExitOnBenchmarkError( "Can't read the base64 file.",
+                                  RESULT_CANT_READ_ENCRYPTED_FILE );
+        }
+    }
+
+    CloseFileAfterReadingX( &F );
+
+    EndMeasurement( "ReadBytesX base64", BENCHMARK_BUFFER_SIZE, i );
+
+    // Make sure that the base64 routines are working.
+    if( memcmp( BenchmarkBufferA, BenchmarkBufferB, BENCHMARK_BUFFER_SIZE ) )
+    {
+        ExitOnBenchmarkError( "The base64 file was not read back correctly.",
+                              RESULT_INVALID_DECRYPTION_OUTPUT );
+    }
+
+    // Delete the base64 file.
+    remove( "base64.txt" );
+
+    //--------------------------------------------------------------------------
+    // Interleave equal numbers of text and fill bytes.
+
+    // Refer to the context record used for interleaving.
+    c = &BenchmarkContext;
+
+    StartMeasurement();
+
+    for( i = 0; i < ByteCount; i += TEXTFILL_BUFFER_SIZE )
+    {
+        c->BytesToWriteThisPass     = TEXTFILL_BUFFER_SIZE;
+        c->TextBytesToWriteThisPass = TEXT_BUFFER_SIZE;
+        c->FillBytesToWriteThisPass = FILL_BUFFER_SIZE;
+
+        InterleaveTextFillBytes( c, BenchmarkBufferA, BenchmarkBufferB );
+    }
+
+    EndMeasurement( "InterleaveTextFillBytes", TEXTFILL_BUFFER_SIZE, i );
+
+    //--------------------------------------------------------------------------
+    // Separate the text bytes from the fill bytes.
+
+    StartMeasurement();
+
+    for( i = 0; i < ByteCount; i += TEXTFILL_BUFFER_SIZE )
+    {
+        c->BytesToReadThisPass     = TEXTFILL_BUFFER_SIZE;
+        c->TextBytesToReadThisPass = TEXT_BUFFER_SIZE;
+        c->FillBytesToReadThisPass = FILL_BUFFER_SIZE;
+
+        DeinterleaveTextFillBytes( c, BenchmarkBufferA, BenchmarkBufferB );
+    }
+
+    EndMeasurement( "DeinterleaveTextFillBytes", TEXTFILL_BUFFER_SIZE, i );
+
+    // Clear the context record.
+    ZeroBytes( (u8*) c, sizeof(OT7Context) );
+}
+
+/*------------------------------------------------------------------------------
+| ParseSizeString
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To parse a number of bytes from a string.
+|
+| DESCRIPTION: The number may be followed by K, M or G to multiply it by
+| 1024, 1024^2 or 1024^3.
+|
+| EXAMPLE:              n = ParseSizeString( "10G" );
+|
+| HISTORY:
+|    16Oct26
+------------------------------------------------------------------------------*/
+    // OUT: The number of bytes.
+u64 //
+ParseSizeString( s8* S )
+{
+    u64 n;
+
+    // Parse the number, leaving S at the first character after it.
+    n = ParseUnsignedInteger( &S, S + strlen(S) );
+
+    // Apply any size suffix.
+    switch( *S )
+    {
+        case 'k': case 'K': { n <<= 10; break; }
+        case 'm': case 'M': { n <<= 20; break; }
+        case 'g': case 'G': { n <<= 30; break; }
+    }
+
+    // Return the number of bytes.
+    return( n );
+}
+
+/*------------------------------------------------------------------------------
+| PrintBenchmarkResults
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To print the measurements in the format selected on the command
+|          line.
+|
+| DESCRIPTION: Speeds are in megabytes (2^20 bytes) per second. The cycles per
+| byte are left out if the processor has no cycle counter.
+|
+| HISTORY:
+|    16Oct26
+------------------------------------------------------------------------------*/
+void
+PrintBenchmarkResults()
+{
+    u32 i;
+    BenchmarkResult* R;
+    double MegabytesPerSecond;
+    double CyclesPerByte;
+
+    // Print the headings.
+    switch( OutputFormat )
+    {
+        case BENCHMARK_OUTPUT_TEXT:
+        {
+            printf( "OT7 benchmark using the %s hash routines.\n\n",
+                    Skein1024ActiveKernel->Name );
+
+            printf( "Test                       Size (bytes)      Seconds"
+                    "        MB/s  cycles/byte\n" );
+            break;
+        }
+
+        case BENCHMARK_OUTPUT_CSV:
+        {
+            printf( "test,size_bytes,total_bytes,seconds,mb_per_s,"
+                    "cycles_per_byte,hash_routines\n" );
+            break;
+        }
+
+        case BENCHMARK_OUTPUT_JSON:
+        {
+            printf( "{\n  \"hash_routines\": \"%s\",\n  \"results\": [\n",
+                    Skein1024ActiveKernel->Name );
+            break;
+        }
+    }
+
+    // Print each result.
+    for( i = 0; i < BenchmarkResultCount; i++ )
+    {
+        R = &BenchmarkResults[i];
+
+        // Compute the speed, avoiding division by zero for very short times.
+        MegabytesPerSecond =
+            ( (double) R->TotalBytes / 1048576.0 ) /
+            ( R->Seconds > 1e-6 ? R->Seconds : 1e-6 );
+
+        CyclesPerByte = (double) R->Cycles / (double) R->TotalBytes;
+
+        switch( OutputFormat )
+        {
+            case BENCHMARK_OUTPUT_TEXT:
+            {
+                printf( "%-26s %12s %12.4f %11.1f",
+                        R->TestName,
+                        ConvertIntegerToString64( R->Size ),
+                        R->Seconds,
+                        MegabytesPerSecond );
+
+                if( R->Cycles )
+                {
+                    printf( " %12.2f\n", CyclesPerByte );
+                }
+                else
+                {
+                    printf( " %12s\n", "n/a" );
+                }
+                break;
+            }
+
+            case BENCHMARK_OUTPUT_CSV:
+            {
+                printf( "%s,%s,",
+                        R->TestName, ConvertIntegerToString64( R->Size ) );
+
+                printf( "%s,%.6f,%.2f,",
+                        ConvertIntegerToString64( R->TotalBytes ),
+                        R->Seconds,
+                        MegabytesPerSecond );
+
+                if( R->Cycles )
+                {
+                    printf( "%.3f", CyclesPerByte );
+                }
+
+                printf( ",%s\n", Skein1024ActiveKernel->Name );
+                break;
+            }
+
+            case BENCHMARK_OUTPUT_JSON:
+            {
+                printf( "    { \"test\": \"%s\", \"size_bytes\": %s, ",
+                        R->TestName, ConvertIntegerToString64( R->Size ) );
+
+                printf( "\"total_bytes\": %s, \"seconds\": %.6f, "
+                        "\"mb_per_s\": %.2f, \"cycles_per_byte\": ",
+                        ConvertIntegerToString64( R->TotalBytes ),
+                        R->Seconds,
+                        MegabytesPerSecond );
+
+                if( R->Cycles )
+                {
+                    printf( "%.3f }", CyclesPerByte );
+                }
+                else
+                {
+                    printf( "null }" );
+                }
+
+                printf( "%s\n", (i + 1 < BenchmarkResultCount) ? "," : "" );
+                break;
+            }
+        }
+    }
+
+    // Close the JSON object.
+    if( OutputFormat == BENCHMARK_OUTPUT_JSON )
+    {
+        printf( "  ]\n}\n" );
+    }
+}
+
+/*------------------------------------------------------------------------------
+| ReadWallClockSeconds
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To read the time in seconds for measuring elapsed time.
+|
+| DESCRIPTION: Wall clock time is used rather than processor time so that time
+| spent waiting for file I/O is included in the measurements.
+|
+| HISTORY:
+|    16Oct26
+------------------------------------------------------------------------------*/
+    // OUT: Time in seconds from some fixed starting point.
+double //
+ReadWallClockSeconds()
+{
+#if defined( _MSC_VER )
+
+    return( (double) clock() / CLOCKS_PER_SEC );
+
+#else
+
+    struct timeval t;
+
+    gettimeofday( &t, 0 );
+
+    return( (double) t.tv_sec + (double) t.tv_usec * 1e-6 );
+
+#endif // _MSC_VER
+}
+
+/*------------------------------------------------------------------------------
+| StartMeasurement
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To start measuring the time taken by some code.
+|
+| DESCRIPTION: See also EndMeasurement().
+|
+| HISTORY:
+|    16Oct26
+------------------------------------------------------------------------------*/
+void
+StartMeasurement()
+{
+    MeasurementStartSeconds = ReadWallClockSeconds();
+    MeasurementStartCycles  = ReadCycleCounter();
+}
@@ -303,6 +303,13 @@ int Result;
 #define RESULT_SKEIN_TEST_FINAL_RESULT_IS_INVALID      45
 #define RESULT_SKEIN_TEST_INITIALIZATION_FAILED        46
 #define RESULT_TEXT_LINE_TOO_LONG_FOR_BUFFER           47
+#define RESULT_CANT_READ_LOG_FILE                      48
+#define RESULT_CANT_READ_BATCH_FILE                    49
+#define RESULT_RANGE_STARTS_PAST_END_OF_TEXT           50
+#define RESULT_DUPLICATE_BATCH_FILE_NAME               51
+#define RESULT_LOG_FILE_CHANGED_BY_EARLIER_VERSION     52
+#define RESULT_KEY_BYTES_USED_BY_ANOTHER_PROCESS       53
+#define RESULT_KEY_FILE_USED_UP                        54
  
 /*------------------------------------------------------------------------------
 | ResultCodeAndString
@@ -485,21 +492,54 @@ ResultCodesOT7[] =
     { RESULT_TEXT_LINE_TOO_LONG_FOR_BUFFER,
      "RESULT_TEXT_LINE_TOO_LONG_FOR_BUFFER" }, 
      
+    { RESULT_CANT_READ_LOG_FILE,
+     "RESULT_CANT_READ_LOG_FILE" }, 
+     
+    { RESULT_CANT_READ_BATCH_FILE,
+     "RESULT_CANT_READ_BATCH_FILE" }, 
+     
+    { RESULT_RANGE_STARTS_PAST_END_OF_TEXT,
+     "RESULT_RANGE_STARTS_PAST_END_OF_TEXT" }, 
+     
+    { RESULT_DUPLICATE_BATCH_FILE_NAME,
+     "RESULT_DUPLICATE_BATCH_FILE_NAME" }, 
+
+    { RESULT_LOG_FILE_CHANGED_BY_EARLIER_VERSION,
+     "RESULT_LOG_FILE_CHANGED_BY_EARLIER_VERSION" }, 
+
+    { RESULT_KEY_BYTES_USED_BY_ANOTHER_PROCESS,
+     "RESULT_KEY_BYTES_USED_BY_ANOTHER_PROCESS" },
+     
+    { RESULT_KEY_FILE_USED_UP,
+     "RESULT_KEY_FILE_USED_UP" },
+
     { 0, 0 } // This record marks the end of the list.
 };
 
 s8*   ConvertIntegerToString64( u64 n );
+void  ExitOnFailedTest( s8* TestName, s8* Reason, int ResultCode );
+u32   FlipBitInFile( s8* FileName, u64 Offset );
+u32   GenerateCompressibleFile( s8* FileName, u64 FileSize );
 u8    GeneratePseudoRandomByte();
 u32   GenerateRandomFile( s8* FileName, u64 FileSize );
 u64   Get_u64_LSB_to_MSB( u8* Buffer );
 u64   GetFileSize64( FILE* F );
+u64   GetFileSizeByName( s8* FileName );
 void  InitPseudoRandomGenerator( u8* Seed, u32 ByteCount );
+u32   IsFilePartOfFile(
+            s8* AFileName,
+            s8* BFileName,
+            u64 Offset,
+            u64 ByteCount );
+u32   IsFileStartOfFile( s8* AFileName, s8* BFileName );
 u32   IsFilesIdentical( s8* AFileName, s8* BFileName );
+u32   IsStringInFile( s8* FileName, s8* AString );
 s8*   LookUpResultCodeString( int ResultCode );
 int   main( int argc, char* argv[] );
 void  Put_u64_LSB_to_MSB( u64 n, u8* Buffer );
 u32   ReadByte( FILE* FileHandle, u8* BufferAddress );
 u32   ReadBytes( FILE* FileHandle, u8* BufferAddress, u32 NumberOfBytes );
+u32   ReadNumberAfterStringInFile( s8* FileName, s8* AString, u64* Number );
 void  ReverseString( s8* A );
 void  Skein_Get64_LSB_First( u64* dst, u8* src, u32 WordCount );
 void  Skein_Put64_LSB_First( u8* dst, u64* src, u32 ByteCount );
@@ -517,6 +557,15 @@ u32   Skein1024_Test();
 u32   Skein1024_TestCase( u8* MessageData, u32 MessageSize, u8* ExpectedResult );
 void  Skein1024_Update( Skein1024Context* ctx, u8* msg, u32 msgByteCnt );
 int   Test( s8* CommandLineString, int ExpectedResultCode );
+void  TestBatch();
+void  TestCompressedRecord( u64 FileSize );
+void  TestConcurrentEncryption( u32 ProcessCount );
+void  TestDamagedTaggedRecord( u64 FileSize, u64 DamagedOffset );
+void  TestDecryptRanges(
+            s8* RecordName,
+            s8* EncryptionCommandString,
+            u64 FileSize,
+            u32 IsCompressible );
 
 int   TestEncryptDecryptFile( 
             u64 FileSize, 
@@ -537,12 +586,45 @@ void TestEncryptDecryptFiles_EncryptedFileFormatBase64(
             u64 StartFileSize, 
             u64 EndFileSize, 
             u64 SizeIncrement );
+
+void TestEncryptDecryptFiles_Compressed(
+            u64 StartFileSize, 
+            u64 EndFileSize, 
+            u64 SizeIncrement );
             
+void TestEncryptDecryptFiles_FillPolicy(
+            u64 StartFileSize,
+            u64 EndFileSize,
+            u64 SizeIncrement,
+            s8* FillPolicy );
+
 void TestEncryptDecryptFiles_NoFileName( 
             u64 StartFileSize, 
             u64 EndFileSize, 
             u64 SizeIncrement );
              
+void TestEncryptDecryptFiles_StandardStreams(
+            u64 StartFileSize, 
+            u64 EndFileSize, 
+            u64 SizeIncrement );
+
+void TestEncryptDecryptFiles_Tagged(
+            u64 StartFileSize, 
+            u64 EndFileSize, 
+            u64 SizeIncrement );
+
+void TestEncryptDecryptFiles_Streamed(
+            u64 StartFileSize, 
+            u64 EndFileSize, 
+            u64 SizeIncrement );
+
+void  TestKeyMapCache();
+void  TestKeyMapIdentifiers();
+void  TestKeyMapLookUp( s8* Options, s8* KeyFileName, u32 IsCached );
+void  TestLogExportImport( u64 FileSize );
+void  TestLostKeyUsageLog( u64 FileSize );
+void  TestSeekableThreads( u64 FileSize, u32 ChunkSize );
+void  TestStandardStreamDecryption();
 u32   WriteByte( FILE* FileHandle, u8 AByte );
 u32   WriteBytes( FILE* FileHandle, u8* BufferAddress, u32 AByteCount );
 void  ZeroBytes( u8* Destination, u32 AByteCount );
@@ -571,6 +653,19 @@ void  ZeroBytes( u8* Destination, u32 AByteCount );
 |
 | HISTORY: 
 |    26Dec14
+|    17Oct26 Added tests of streamed records and standard streams.
+|    17Oct26 Added tests of tagged records and resuming decryption.
+|    17Oct26 Added tests of compressed records.
+|    17Oct26 Added tests of fill policies.
+|    17Oct26 Added tests of seekable records made using several threads.
+|    17Oct26 Added tests of exporting, importing and converting log files.
+|    17Oct26 Added tests of batches of files.
+|    17Oct26 Added test of restoring a lost key usage log.
+|    17Oct26 Added test of the key map cache.
+|    17Oct26 Added test of looking up key definitions by identifier.
+|    17Oct26 Added tests of decrypting part of a record.
+|    17Oct26 Added test that '-' isn't used as a file name when decrypting.
+|    17Oct26 Added test of encrypting in several processes at once.
 ------------------------------------------------------------------------------*/
     // OUT: Result code from interpreting the command line function.
 int //
@@ -636,8 +731,111 @@ main( int argc, char* argv[] )
     TestEncryptDecryptFiles_NoFileName( 0xFFF0LL, 0x10005LL, 1LL );
     TestEncryptDecryptFiles_EncryptedFileFormatBinary( 0xFFF0LL, 0x10005LL, 1LL );
     TestEncryptDecryptFiles_EncryptedFileFormatBase64( 0xFFF0LL, 0x10005LL, 1LL );
+
+    printf( "Generating a 10,000,000 byte encryption key file named '123.key'.\n" );
+
+    // Generate a new 10,000,000 byte key file named '123.key' for the tests of
+    // other record formats below.
+    GenerateRandomFile( "123.key", 10000000LL );
+
+    printf( "Test streamed records made from plaintext read from standard\n" );
+    printf( "input, including empty input, and records written to standard\n" );
+    printf( "output.\n" );
+
+    TestEncryptDecryptFiles_Streamed( 0LL, 100LL, 1LL );
+    TestEncryptDecryptFiles_Streamed( 4000LL, 8500LL, 250LL );
+    TestEncryptDecryptFiles_StandardStreams( 0LL, 100LL, 1LL );
+    TestEncryptDecryptFiles_StandardStreams( 4000LL, 8500LL, 250LL );
+    TestStandardStreamDecryption();
      
-    // Getting to this point implies success with Result = RESULT_OK (0).
+    printf( "Test tagged records, including finding a damaged chunk and\n" );
+    printf( "resuming decryption after it has been repaired.\n" );
+
+    TestEncryptDecryptFiles_Tagged( 0LL, 100LL, 1LL );
+    TestEncryptDecryptFiles_Tagged( 4000LL, 8500LL, 250LL );
+    TestDamagedTaggedRecord( 20000LL, 12000LL );
+    TestDamagedTaggedRecord( 100000LL, 50000LL );
+
+    printf( "Test compressed records, both of random data which is stored\n" );
+    printf( "without compression and of data that can be compressed.\n" );
+
+    TestEncryptDecryptFiles_Compressed( 0LL, 100LL, 1LL );
+    TestEncryptDecryptFiles_Compressed( 4000LL, 8500LL, 250LL );
+    TestCompressedRecord( 4096LL );
+    TestCompressedRecord( 100000LL );
+    TestCompressedRecord( 1000000LL );
+
+    printf( "Test the fill policies that limit the number of fill bytes.\n" );
+
+    TestEncryptDecryptFiles_FillPolicy( 0LL, 100LL, 1LL, "bucket" );
+    TestEncryptDecryptFiles_FillPolicy( 4000LL, 70000LL, 2750LL, "bucket" );
+    TestEncryptDecryptFiles_FillPolicy( 0LL, 100LL, 1LL, "5%" );
+    TestEncryptDecryptFiles_FillPolicy( 4000LL, 70000LL, 2750LL, "5%" );
+
+    printf( "Test that seekable records are the same for any number of\n" );
+    printf( "threads.\n" );
+
+    TestSeekableThreads( 0LL, 4096 );
+    TestSeekableThreads( 30000LL, 4096 );
+    TestSeekableThreads( 1000000LL, 4096 );
+    TestSeekableThreads( 1000000LL, 65536 );
+
+    printf( "Test decrypting part of each kind of record, including parts\n" );
+    printf( "that cross chunk boundaries, empty parts and parts that start\n" );
+    printf( "past the end of the plaintext.\n" );
+
+    TestDecryptRanges(
+        "sized",
+        "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -silent",
+        200000LL,
+        0 );
+
+    TestDecryptRanges(
+        "seekable",
+        "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -seekable "
+        "-chunk 4096 -silent",
+        200000LL,
+        0 );
+
+    TestDecryptRanges(
+        "streamed",
+        "./ot7 -e - -oe encrypted.bin -KeyID 123 -chunk 4096 -silent "
+        "< plain.bin",
+        200000LL,
+        0 );
+
+    TestDecryptRanges(
+        "compressed",
+        "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -compress -silent",
+        200000LL,
+        1 );
+
+    printf( "Test exporting and importing the log file, and converting a\n" );
+    printf( "log file in the older text format.\n" );
+
+    TestLogExportImport( 3000LL );
+    TestLostKeyUsageLog( 3000LL );
+
+    printf( "Test that processes encrypting at the same time using the\n" );
+    printf( "same key file don't use the same key bytes.\n" );
+
+    TestConcurrentEncryption( 12 );
+
+    printf( "Test batches of files given by a directory and by a list.\n" );
+
+    TestBatch();
+
+    printf( "Test that the key map cache is rebuilt after the key map file\n" );
+    printf( "is changed without changing its size or modification time.\n" );
+
+    TestKeyMapCache();
+
+    printf( "Test looking up key definitions by identifier, with and\n" );
+    printf( "without the key map cache.\n" );
+
+    TestKeyMapIdentifiers();
+
+// Getting to this point implies success with Result = RESULT_OK (0).
 
     printf( "All tests passed OK.\n" );
          
@@ -701,6 +899,161 @@ NextDigit://
     return( (s8*) &s[0] );
 }
 
+/*------------------------------------------------------------------------------
+| ExitOnFailedTest
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To report a failed test and exit from this application.
+|
+| DESCRIPTION: The working files are left on the disk for later analysis.
+|
+| HISTORY:
+|    17Oct26
+------------------------------------------------------------------------------*/
+void
+ExitOnFailedTest(
+    s8* TestName,
+            // Name of the test that failed.
+            //
+    s8* Reason,
+            // Why the test failed.
+            //
+    int ResultCode )
+            // Result code to return from this application.
+{
+    printf( "FAIL: %s.\n", TestName );
+
+    printf( "      %s\n", Reason );
+
+    printf( "ENDING TEST EARLY ON FIRST FAILURE.\n" );
+
+    // Exit from this test application, returning the result code.
+    exit( ResultCode );
+}
+
+/*------------------------------------------------------------------------------
+| FlipBitInFile
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To change the low bit of a byte in a file.
+|
+| DESCRIPTION: This is used to damage an encrypted file. Calling it again with
+| the same offset repairs the file.
+|
+| HISTORY:
+|    17Oct26
+------------------------------------------------------------------------------*/
+    // OUT: Result code RESULT_OK if successful, or an error code if not.
+u32 //
+FlipBitInFile( s8* FileName, u64 Offset )
+{
+    FILE* F;
+    u8    AByte;
+    u32   Result;
+
+    // Open the file to read and write binary data.
+    F = fopen64( FileName, "r+b" );
+
+    // If unable to open the file, then return an error code.
+    if( F == 0 )
+    {
+        return( RESULT_CANT_OPEN_FILE_FOR_WRITING );
+    }
+
+    // Start with an error code that means the file couldn't be changed.
+    Result = RESULT_CANT_WRITE_FILE;
+
+    // Read the byte at the offset, and write it back with the low bit
+    // changed.
+    if( ( fseeko64( F, (s64) Offset, SEEK_SET ) == 0 ) &&
+        ( ReadByte( F, &AByte ) == 1 ) &&
+        ( fseeko64( F, (s64) Offset, SEEK_SET ) == 0 ) &&
+        ( WriteByte( F, (u8) ( AByte ^ 1 ) ) == 1 ) )
+    {
+        Result = RESULT_OK;
+    }
+
+    // Close the file.
+    fclose( F );
+
+    // Return the result code.
+    return( Result );
+}
+
+/*------------------------------------------------------------------------------
+| GenerateCompressibleFile
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To generate a file that can be compressed.
+|
+| DESCRIPTION: The file is made of 4096-byte blocks that alternate between a
+| repeated line of text and pseudo-random bytes, starting with text. When the
+| file is encrypted with '-compress -chunk 4096', the text blocks compress well
+| and the random blocks have to be stored without compression, so both kinds
+| of compressed chunk are used.
+|
+| HISTORY:
+|    17Oct26 From GenerateRandomFile().
+------------------------------------------------------------------------------*/
+    // OUT: Result code RESULT_OK if successful, or an error code if not.
+u32 //
+GenerateCompressibleFile( s8* FileName, u64 FileSize )
+{
+    FILE* F;
+    u64   i;
+    u32   BytesWritten;
+    u8    AByte;
+    s8*   Line;
+
+    // Refer to the line of text to repeat in the text blocks.
+    Line = "The quick brown fox jumps over the lazy dog.\n";
+
+    // Open an output file to write binary data.
+    F = fopen64( FileName, "wb" );
+
+    // If unable to open the file, then return an error code.
+    if( F == 0 )
+    {
+        return( RESULT_CANT_OPEN_FILE_FOR_WRITING );
+    }
+
+    // Write enough bytes to make a file of the given size.
+    for( i = 0; i < FileSize; i++ )
+    {
+        // If this byte is in an odd numbered block, then use a pseudo-random
+        // byte.
+        if( ( i / 4096 ) & 1 )
+        {
+            AByte = GeneratePseudoRandomByte();
+        }
+        else // This byte is in a text block.
+        {
+            // Use the next byte of the repeated line.
+            AByte = (u8) Line[ i % strlen( Line ) ];
+        }
+
+        // Write one byte to the file.
+        BytesWritten = WriteByte( F, AByte );
+
+        // If the byte was not written, then close the file and return an
+        // error result code.
+        if( BytesWritten != 1 )
+        {
+            // Close the file, leaving any partially written file on disk.
+            fclose( F );
+
+            // Return an error code that means the file could not be written.
+            return( RESULT_CANT_WRITE_FILE );
+        }
+    }
+
+    // Close the file after having written the whole file to disk.
+    fclose( F );
+
+    // Return a result code meaning successful completion.
+    return( RESULT_OK );
+}
+
 /*------------------------------------------------------------------------------
 | GeneratePseudoRandomByte
 |-------------------------------------------------------------------------------
@@ -899,6 +1252,45 @@ GetFileSize64( FILE* F )
     return( EndPosition );
 }
 
+/*------------------------------------------------------------------------------
+| GetFileSizeByName
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To return the size of a named file in bytes.
+|
+| DESCRIPTION: The file is opened just long enough to find its size, see
+| GetFileSize64().
+|
+| HISTORY:
+|    17Oct26
+------------------------------------------------------------------------------*/
+    // OUT: The number of bytes in the file, or MAX_VALUE_64BIT if there was
+    //      an error.
+u64 //
+GetFileSizeByName( s8* FileName )
+{
+    FILE* F;
+    u64   FileSize;
+
+    // Open the file for reading binary data.
+    F = fopen64( FileName, "rb" );
+
+    // If unable to open the file, then return MAX_VALUE_64BIT.
+    if( F == 0 )
+    {
+        return( MAX_VALUE_64BIT );
+    }
+
+    // Get the size of the file.
+    FileSize = GetFileSize64( F );
+
+    // Close the file.
+    fclose( F );
+
+    // Return the number of bytes in the file.
+    return( FileSize );
+}
+
 /*------------------------------------------------------------------------------
 | InitPseudoRandomGenerator
 |-------------------------------------------------------------------------------
@@ -934,6 +1326,176 @@ InitPseudoRandomGenerator( u8* Seed, u32 ByteCount )
         ByteCount );
 }
 
+/*------------------------------------------------------------------------------
+| IsFilePartOfFile
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test if one file holds exactly the given part of another file.
+|
+| DESCRIPTION: This is used to check the plaintext written when decrypting
+| part of a record with the '-range' option. An empty file is the part of any
+| file with a byte count of zero.
+|
+| HISTORY:
+|    17Oct26 From IsFileStartOfFile().
+------------------------------------------------------------------------------*/
+    // OUT: 1 if the first file matches the part of the second, or 0 if it
+    //      doesn't or there was an error.
+u32 //
+IsFilePartOfFile(
+    s8* AFileName,
+            // Name of the file that should hold the part.
+            //
+    s8* BFileName,
+            // Name of the file that the part comes from.
+            //
+    u64 Offset,
+            // Offset of the part in the second file.
+            //
+    u64 ByteCount )
+            // Size of the part in bytes.
+{
+    FILE* fA;
+    FILE* fB;
+    u64   ASize, BSize, i;
+    u32   IsMatching;
+    u8    cA, cB;
+
+    // Open the first file for reading binary data.
+    fA = fopen64( AFileName, "rb" );
+
+    // If unable to open the file, then return 0.
+    if( fA == 0 )
+    {
+        return( 0 );
+    }
+
+    // Open the second file for reading binary data.
+    fB = fopen64( BFileName, "rb" );
+
+    // If unable to open the file, then close the first one and return 0.
+    if( fB == 0 )
+    {
+        fclose( fA );
+
+        return( 0 );
+    }
+
+    // Get the sizes of the files, or MAX_VALUE_64BIT if there was an error.
+    ASize = GetFileSize64( fA );
+    BSize = GetFileSize64( fB );
+
+    // The first file can only match if it is the size of the part and the
+    // part is within the second file.
+    IsMatching = ( ASize == ByteCount ) &&
+                 ( BSize != MAX_VALUE_64BIT ) &&
+                 ( Offset <= BSize ) &&
+                 ( ByteCount <= BSize - Offset );
+
+    // Skip over the bytes of the second file before the part.
+    for( i = 0; IsMatching && ( i < Offset ); i++ )
+    {
+        // If unable to read a byte, then the files don't match.
+        if( ReadByte( fB, &cB ) != 1 )
+        {
+            IsMatching = 0;
+        }
+    }
+
+    // Compare the bytes of the first file with the part of the second,
+    // stopping at the first difference.
+    for( i = 0; IsMatching && ( i < ASize ); i++ )
+    {
+        // If unable to read a byte from each file or the bytes differ, then
+        // the files don't match.
+        if( ( ReadByte( fA, &cA ) != 1 ) ||
+            ( ReadByte( fB, &cB ) != 1 ) ||
+            ( cA != cB ) )
+        {
+            IsMatching = 0;
+        }
+    }
+
+    // Close the files.
+    fclose( fA );
+    fclose( fB );
+
+    // Return 1 if the first file matches the part of the second.
+    return( IsMatching );
+}
+
+/*------------------------------------------------------------------------------
+| IsFileStartOfFile
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test if one file holds the first bytes of another file.
+|
+| DESCRIPTION: This is used to check the plaintext kept in the output file when
+| decryption stops early. An empty file is the start of any file.
+|
+| HISTORY:
+|    17Oct26 From IsFilesIdentical().
+------------------------------------------------------------------------------*/
+    // OUT: 1 if the first file matches the start of the second, or 0 if it
+    //      doesn't or there was an error.
+u32 //
+IsFileStartOfFile( s8* AFileName, s8* BFileName )
+{
+    FILE* fA;
+    FILE* fB;
+    u64   ASize, BSize, i;
+    u32   IsMatching;
+    u8    cA, cB;
+
+    // Open the first file for reading binary data.
+    fA = fopen64( AFileName, "rb" );
+
+    // If unable to open the file, then return 0.
+    if( fA == 0 )
+    {
+        return( 0 );
+    }
+
+    // Open the second file for reading binary data.
+    fB = fopen64( BFileName, "rb" );
+
+    // If unable to open the file, then close the first one and return 0.
+    if( fB == 0 )
+    {
+        fclose( fA );
+
+        return( 0 );
+    }
+
+    // Get the sizes of the files, or MAX_VALUE_64BIT if there was an error.
+    ASize = GetFileSize64( fA );
+    BSize = GetFileSize64( fB );
+
+    // The first file can only match if it is no bigger than the second.
+    IsMatching = ( ASize <= BSize ) && ( BSize != MAX_VALUE_64BIT );
+
+    // Compare the bytes of the first file with the start of the second,
+    // stopping at the first difference.
+    for( i = 0; IsMatching && ( i < ASize ); i++ )
+    {
+        // If unable to read a byte from each file or the bytes differ, then
+        // the files don't match.
+        if( ( ReadByte( fA, &cA ) != 1 ) ||
+            ( ReadByte( fB, &cB ) != 1 ) ||
+            ( cA != cB ) )
+        {
+            IsMatching = 0;
+        }
+    }
+
+    // Close the files.
+    fclose( fA );
+    fclose( fB );
+
+    // Return 1 if the first file matches the start of the second.
+    return( IsMatching );
+}
+
 /*------------------------------------------------------------------------------
 | IsFilesIdentical
 |-------------------------------------------------------------------------------
@@ -1110,18 +1672,66 @@ Put_u64_LSB_to_MSB( u64 n, u8* Buffer )
 }
 
 /*------------------------------------------------------------------------------
-| ReadByte
+| IsStringInFile
 |-------------------------------------------------------------------------------
 |
-| PURPOSE: To read a byte from a file to a buffer.
+| PURPOSE: To test if a text file contains a string.
 |
-| DESCRIPTION: Returns the number of bytes read, or MAX_VALUE_32BIT (0xFFFFFFFF)
-| if error or EOF.
+| DESCRIPTION: The file is read one line at a time, so the string must not
+| span lines.
 |
-| HISTORY:  
-|    02Feb89
-|    21Dec89 revised to pass error code
-|    19Oct13 Revised for changes made to ReadBytes().
+| HISTORY:
+|    17Oct26
+------------------------------------------------------------------------------*/
+    // OUT: 1 if the string is in the file, or 0 if it isn't or there was an
+    //      error.
+u32 //
+IsStringInFile( s8* FileName, s8* AString )
+{
+    FILE* F;
+    s8    Line[1024];
+    u32   IsFound;
+
+    // Open the file for reading text.
+    F = fopen64( FileName, "r" );
+
+    // If unable to open the file, then return 0.
+    if( F == 0 )
+    {
+        return( 0 );
+    }
+
+    // Start with the string not found.
+    IsFound = 0;
+
+    // Read lines from the file until the string is found or the end of the
+    // file is reached.
+    while( ( IsFound == 0 ) && fgets( Line, sizeof( Line ), F ) )
+    {
+        // Note if the string is in this line.
+        IsFound = ( strstr( Line, AString ) != 0 );
+    }
+
+    // Close the file.
+    fclose( F );
+
+    // Return 1 if the string was found.
+    return( IsFound );
+}
+
+/*------------------------------------------------------------------------------
+| ReadByte
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To read a byte from a file to a buffer.
+|
+| DESCRIPTION: Returns the number of bytes read, or MAX_VALUE_32BIT (0xFFFFFFFF)
+| if error or EOF.
+|
+| HISTORY:  
+|    02Feb89
+|    21Dec89 revised to pass error code
+|    19Oct13 Revised for changes made to ReadBytes().
 |    07Nov13 Changed return value passing to follow same format as ReadBytes().
 ------------------------------------------------------------------------------*/
     // OUT: Returns the number of bytes read, or MAX_VALUE_32BIT if error or 
@@ -1182,6 +1792,87 @@ ReadBytes( FILE*  FileHandle,
    return( Result );
 }
 
+/*------------------------------------------------------------------------------
+| ReadNumberAfterStringInFile
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To read the decimal number that follows a string in a text file.
+|
+| DESCRIPTION: The file is read one line at a time and the first line holding
+| the string is used. The number must follow the string directly, eg. the
+| string "Set file position to " for the line "Set file position to 32 in key
+| file '123.key'." gives 32.
+|
+| HISTORY:
+|    17Oct26
+------------------------------------------------------------------------------*/
+    // OUT: 1 if a number was found after the string, or 0 if not or there was
+    //      an error.
+u32 //
+ReadNumberAfterStringInFile(
+    s8* FileName,
+            // Name of the text file to read.
+            //
+    s8* AString,
+            // The string that the number follows.
+            //
+    u64* Number )
+            // OUT: The number found.
+{
+    FILE* F;
+    s8    Line[1024];
+    s8*   S;
+    u32   IsFound;
+
+    // Open the file for reading text.
+    F = fopen64( FileName, "r" );
+
+    // If unable to open the file, then return 0.
+    if( F == 0 )
+    {
+        return( 0 );
+    }
+
+    // Start with the string not found.
+    S = 0;
+
+    // Read lines from the file until the string is found or the end of the
+    // file is reached.
+    while( ( S == 0 ) && fgets( Line, sizeof( Line ), F ) )
+    {
+        // Look for the string in this line.
+        S = strstr( Line, AString );
+    }
+
+    // Close the file.
+    fclose( F );
+
+    // Start with no number found.
+    IsFound = 0;
+    
+    // If the string was found, then convert the digits after it.
+    if( S )
+    {
+        // Start with a value of zero.
+        *Number = 0;
+        
+        // Skip over the string.
+        S += strlen( AString );
+        
+        // Add in each digit.
+        while( ( *S >= '0' ) && ( *S <= '9' ) )
+        {
+            *Number = *Number * 10 + (u64) ( *S++ - '0' );
+            
+            // Note that a digit was found.
+            IsFound = 1;
+        }
+    }
+
+    // Return 1 if a number was found.
+    return( IsFound );
+}
+
 /*------------------------------------------------------------------------------
 | ReverseString
 |-------------------------------------------------------------------------------
@@ -1679,14 +2370,15 @@ Test( s8* CommandLineString, int ExpectedResultCode )
                 Result,
                 LookUpResultCodeString( Result ) );
 
-        if( Result == RESULT_RAN_OUT_OF_KEY_IN_ONE_TIME_PAD )
+        if( Result == RESULT_RAN_OUT_OF_KEY_IN_ONE_TIME_PAD ||
+            Result == RESULT_CANT_READ_LOG_FILE )
         {
             printf( "      This is the normal result of running ot7test more\n" );
-            printf( "      than once because 'ot7.log' keeps a record of unused\n" );
-            printf( "      bytes in key files. To fix this, erase file 'ot7.log'.\n" );
-            printf( "      Make a backup copy of 'ot7.log' to preserve records of\n" );
-            printf( "      any other key files used with ot7, and then restore the\n" );
-            printf( "      'ot7.log' file after you are finished running ot7test.\n" );
+            printf( "      than once because 'ot7.log.bin' and 'ot7.log' keep a\n" );
+            printf( "      record of unused bytes in key files. To fix this, erase\n" );
+            printf( "      both files. Make backup copies of them to preserve\n" );
+            printf( "      records of any other key files used with ot7, and then\n" );
+            printf( "      restore them after you are finished running ot7test.\n" );
         }
                 
         printf( "ENDING TEST EARLY ON FIRST FAILURE.\n" );
@@ -1707,373 +2399,2146 @@ Test( s8* CommandLineString, int ExpectedResultCode )
 }
 
 /*------------------------------------------------------------------------------
-| TestEncryptDecryptFile
+| TestBatch
 |-------------------------------------------------------------------------------
 |
-| PURPOSE: To test OT7 encryption and decryption for a file of a given size.
-|
-| DESCRIPTION: This routine generates a random plaintext file of a certain size,
-| then encrypts it, decrypts it, and compares the results.
-|
-| If the original plaintext file and the decrypted files match exactly, then the
-| working files are deleted and RESULT_OK is returned. Otherwise, the working 
-| files are left on the disk for later analysis and this test application exits
-| immediately, returning the error code from OT7.
-|
-| EXAMPLE: To test the encryption of a 5000 byte file using key file "123.key"
-| while suppressing output from OT7, use this call:
-|
-|    TestEncryptDecryptFile( 
-|       5000,
-|       "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -silent",
-|       "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 -silent" );
+| PURPOSE: To test encryption and decryption of batches of files given by a
+|          directory or by a list file.
 |
-| Encryption and description command strings can be varied somewhat to test
-| various features, but the strings must begin as follows in order for this
-| routine to work:
+| DESCRIPTION: Three random files of different sizes, including an empty one,
+| are made in the directory 'batchin'.
 |
-| Encryption command prefix: "./ot7 -e plain.bin -oe encrypted.bin" ...
-| Decryption command prefix: "./ot7 -d encrypted.bin -od decrypted.bin" ...
+| The whole directory is encrypted to 'batchenc' and then decrypted to
+| 'batchdec', and the decrypted files are compared to the originals.
 |
-| This routine generates a plaintext file named 'plain.bin'.
+| Then a list file 'batch.txt' naming two of the files and a missing file is
+| encrypted. This should fail with RESULT_CANT_OPEN_PLAINTEXT_FILE_FOR_READING
+| for the missing file, but the other two files should still be encrypted next
+| to their plaintext files.
 |
-| The encrypted output file needs to be named 'encrypted.bin'.
+| If the test passes, then the working files are deleted. Otherwise they are
+| left on the disk and this test application exits.
 |
-| The file decrypted from 'encrypted.bin' is named 'decrypted.bin', and if
-| everything works as it should, then 'decrypted.bin' will be identical to
-| 'plain.bin'.
+| EXAMPLE: TestBatch();
 |
-| HISTORY: 
-|    31Dec14
+| HISTORY:
+|    17Oct26
 ------------------------------------------------------------------------------*/
-    // OUT: Result code RESULT_OK if successful, or application exit with an 
-int //      error code if not.
-TestEncryptDecryptFile( 
-    u64 FileSize,
-    s8* EncryptionCommandString,
-    s8* DecryptionCommandString )
+void
+TestBatch()
 {
     // Print a dividing line between tests to make reading log files easier.
     printf( "**************************************************************"
             "******************\n" );
-  
-    printf( "TestEncryptDecryptFile for file size %s.\n",
-            ConvertIntegerToString64( FileSize ) );
 
-    // Generate a plaintext file of the given size and filled with pseudo-random
-    // bytes.
-    //
-    // OUT: Result code RESULT_OK if successful, or an error code if not.
-    Result = GenerateRandomFile( "plain.bin", FileSize );
-    
-    // If unable to generate the plaintext file, then exit with the error code.
-    if( Result != RESULT_OK )
+    printf( "TestBatch.\n" );
+
+    // Delete any directories left from an earlier test, and make new ones.
+    Test( "rm -rf batchin batchenc batchdec batch.txt", RESULT_OK );
+    Test( "mkdir batchin batchenc batchdec", RESULT_OK );
+
+    // Generate the plaintext files in the input directory.
+    if( ( GenerateRandomFile( "batchin/a.bin", 100LL ) != RESULT_OK ) ||
+        ( GenerateRandomFile( "batchin/b.bin", 5000LL ) != RESULT_OK ) ||
+        ( GenerateRandomFile( "batchin/c.bin", 0LL ) != RESULT_OK ) )
     {
-        printf( "FAIL: TestEncryptDecryptFile for file size %s.\n",
-                 ConvertIntegerToString64( FileSize ) );
-         
-        printf( "      Unable to generate plaintext file.\n" );
-        
-        printf( "Exiting OT7 test program with result code %d = %s.\n", 
-                 Result,
-                 LookUpResultCodeString( Result ) );
-         
-        printf( "ENDING TEST EARLY ON FIRST FAILURE.\n" );
-  
-        // Exit from this test application, returning the result code from
-        // this test file.        
-        exit( Result );
+        ExitOnFailedTest( "TestBatch",
+                          "Unable to generate plaintext files.",
+                          RESULT_CANT_WRITE_FILE );
     }
-    
-    // Encrypt 'plain.bin' to file 'encrypted.bin' using KeyID 123 and key
-    // file '123.key'. Exits this application if result is not RESULT_OK.
-    Test( EncryptionCommandString, RESULT_OK );
-               
-    // Decrypt  'encrypted.bin' to 'decrypted.bin' using KeyID 123 and key
-    // file '123.key'. Exits this application if result is not RESULT_OK.
-    Test( DecryptionCommandString, RESULT_OK );
-    
-    // If the original generated plaintext file matches the decrypted file,
-    // then delete the working files and return RESULT_OK.
-    if( IsFilesIdentical( "plain.bin", "decrypted.bin" ) )
+
+    // Encrypt all of the files in the input directory.
+    Test( "./ot7 -e -batch batchin -KeyID 123 -oe batchenc -silent",
+          RESULT_OK );
+
+    // Decrypt all of the encrypted files.
+    Test( "./ot7 -d -batch batchenc -KeyID 123 -od batchdec -silent",
+          RESULT_OK );
+
+    // If any decrypted file doesn't match its plaintext, then fail.
+    if( ( IsFilesIdentical( "batchin/a.bin", "batchdec/a.bin" ) == 0 ) ||
+        ( IsFilesIdentical( "batchin/b.bin", "batchdec/b.bin" ) == 0 ) ||
+        ( IsFilesIdentical( "batchin/c.bin", "batchdec/c.bin" ) == 0 ) )
     {
-        // Delete the generated plaintext file.
-        remove( "plain.bin" );
-        
-        // Delete the encrypted output file.
-        remove( "encrypted.bin" );
-        
-        // Delete the decrypted output file.
-        remove( "decrypted.bin" );
-        
-        printf( "PASS: TestEncryptDecryptFile for file size %s.\n",
-                 ConvertIntegerToString64( FileSize ) );
+        ExitOnFailedTest( "TestBatch",
+                          "Decrypted file does not match original plaintext.",
+                          RESULT_INVALID_DECRYPTION_OUTPUT );
     }
-    else // The files don't match.
+
+    // Make a list of files to encrypt, including one that doesn't exist.
+    Test( "printf 'batchin/a.bin\\nbatchin/missing.bin\\nbatchin/b.bin\\n' "
+          "> batch.txt",
+          RESULT_OK );
+
+    // Encrypting the list should fail for the missing file.
+    Test( "./ot7 -e -batch batch.txt -KeyID 123 -silent",
+          RESULT_CANT_OPEN_PLAINTEXT_FILE_FOR_READING );
+
+    // The other files should have been encrypted, so decrypt them and compare
+    // them to their plaintext files.
+    Test( "./ot7 -d batchin/a.bin.ot7 -od decrypted.bin -KeyID 123 -silent",
+          RESULT_OK );
+
+    if( IsFilesIdentical( "batchin/a.bin", "decrypted.bin" ) == 0 )
     {
-        printf( "FAIL: TestEncryptDecryptFile for file size %s.\n",
-                 ConvertIntegerToString64( FileSize ) );
-         
-        printf( "      Decrypted file does not match original plaintext.\n" );
-         
-        printf( "ENDING TEST EARLY ON FIRST FAILURE.\n" );
-  
-        // Exit from this test application, returning the result code from
-        // OT7.        
-        exit( RESULT_INVALID_DECRYPTION_OUTPUT );
+        ExitOnFailedTest( "TestBatch",
+                          "Decrypted file does not match original plaintext.",
+                          RESULT_INVALID_DECRYPTION_OUTPUT );
     }
-     
-    // Return RESULT_OK.
-    return( RESULT_OK );
+
+    remove( "decrypted.bin" );
+
+    Test( "./ot7 -d batchin/b.bin.ot7 -od decrypted.bin -KeyID 123 -silent",
+          RESULT_OK );
+
+    if( IsFilesIdentical( "batchin/b.bin", "decrypted.bin" ) == 0 )
+    {
+        ExitOnFailedTest( "TestBatch",
+                          "Decrypted file does not match original plaintext.",
+                          RESULT_INVALID_DECRYPTION_OUTPUT );
+    }
+
+    // Delete the working files and directories.
+    remove( "decrypted.bin" );
+    Test( "rm -rf batchin batchenc batchdec batch.txt", RESULT_OK );
+
+    printf( "PASS: TestBatch.\n" );
 }
 
 /*------------------------------------------------------------------------------
-| TestEncryptDecryptFiles_DefaultOptions
+| TestCompressedRecord
 |-------------------------------------------------------------------------------
 |
-| PURPOSE: To test encryption and decryption of a range of file sizes using
-|          key file '123.key' and default OT7 options, suppressing OT7 user
-|          message output with the '-silent' option.
-|
-| DESCRIPTION: Only returns from this routine if all tests pass, otherwise 
-| exiting on the first failure.
+| PURPOSE: To test that compressible data is made smaller by '-compress' and
+|          decrypts to the original plaintext.
 |
-| See the description of TestEncryptDecryptFile() for details.
+| DESCRIPTION: A compressible plaintext file 'plain.bin' is made with
+| GenerateCompressibleFile() and encrypted with '-compress -chunk 4096' to a
+| binary record in 'encrypted.bin'. No fill is used, so the record should be
+| smaller than the plaintext whenever there is a text block to compress.
 |
-| EXAMPLE: To test all files sizes from 1 to 3000 bytes, use this call:
+| If the test passes, then the working files are deleted. Otherwise they are
+| left on the disk and this test application exits.
 |
-|   TestEncryptDecryptFiles_DefaultOptions( 1LL, 3000LL, 1LL ); 
+| EXAMPLE: TestCompressedRecord( 100000LL );
 |
-| HISTORY:  
-|    31Dec14 
+| HISTORY:
+|    17Oct26
 ------------------------------------------------------------------------------*/
 void
-TestEncryptDecryptFiles_DefaultOptions( 
-    u64 StartFileSize, 
-    u64 EndFileSize, 
-    u64 SizeIncrement )
+TestCompressedRecord( u64 FileSize )
 {
-    u64 FileSize;
-    
+    u64 EncryptedSize;
+
     // Print a dividing line between tests to make reading log files easier.
-    printf( "@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@"
-            "@@@@@@@@@@@@@@@@@@\n" );
-  
-    printf( "TestEncryptDecryptFiles_DefaultOptions for file \n" );
-    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
-    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
-    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
-      
-    // Test the encryption and decryption of all file sizes from the starting
-    // file size to the ending file size, stepping by the given increment.
-    for( FileSize  = StartFileSize; 
-         FileSize <= EndFileSize; 
-         FileSize += SizeIncrement )
+    printf( "**************************************************************"
+            "******************\n" );
+
+    printf( "TestCompressedRecord for file size %s.\n",
+            ConvertIntegerToString64( FileSize ) );
+
+    // Generate a compressible plaintext file of the given size.
+    if( GenerateCompressibleFile( "plain.bin", FileSize ) != RESULT_OK )
     {
-        // Generate a file of the current size, encrypt it, and decrypt it, 
-        // and compare the results.
-        //
-        // Returns if successful, or application exits with an error code if 
-        // not.
-        TestEncryptDecryptFile( 
-            FileSize,
-            "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -silent",
-            "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 -silent" );
+        ExitOnFailedTest( "TestCompressedRecord",
+                          "Unable to generate plaintext file.",
+                          RESULT_CANT_WRITE_FILE );
     }
-    
-    printf( "PASS: TestEncryptDecryptFiles_DefaultOptions for file \n" );
-    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
-    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
-    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+
+    // Encrypt 'plain.bin' to a compressed record without fill.
+    Test( "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -compress "
+          "-chunk 4096 -f 0 -binary -silent",
+          RESULT_OK );
+
+    // Get the size of the encrypted file.
+    EncryptedSize = GetFileSizeByName( "encrypted.bin" );
+
+    // If the record isn't smaller than the plaintext, then fail.
+    if( EncryptedSize >= FileSize )
+    {
+        ExitOnFailedTest( "TestCompressedRecord",
+                          "Encrypted file is not smaller than the plaintext.",
+                          RESULT_INVALID_DECRYPTION_OUTPUT );
+    }
+
+    printf( "Compressed %s bytes ", ConvertIntegerToString64( FileSize ) );
+    printf( "to a record of %s bytes.\n",
+            ConvertIntegerToString64( EncryptedSize ) );
+
+    // Decrypt the compressed record.
+    Test( "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 -silent",
+          RESULT_OK );
+
+    // If the decrypted file doesn't match the plaintext, then fail.
+    if( IsFilesIdentical( "plain.bin", "decrypted.bin" ) == 0 )
+    {
+        ExitOnFailedTest( "TestCompressedRecord",
+                          "Decrypted file does not match original plaintext.",
+                          RESULT_INVALID_DECRYPTION_OUTPUT );
+    }
+
+    // Delete the working files.
+    remove( "plain.bin" );
+    remove( "encrypted.bin" );
+    remove( "decrypted.bin" );
+
+    printf( "PASS: TestCompressedRecord for file size %s.\n",
+             ConvertIntegerToString64( FileSize ) );
 }
 
 /*------------------------------------------------------------------------------
-| TestEncryptDecryptFiles_EncryptedFileFormatBase64
+| TestConcurrentEncryption
 |-------------------------------------------------------------------------------
 |
-| PURPOSE: To test encryption and decryption of a range of file sizes using key
-|          file '123.key', producing base64 output format for the encrypted
-|          files. 
+| PURPOSE: To test that processes encrypting at the same time with the same
+|          key file don't use the same key bytes.
 |
-| DESCRIPTION: Other OT7 options are defaults and OT7 user message output is 
-| suppressed with the '-silent' option.
-| 
-| Only returns from this routine if all tests pass, otherwise exiting on the 
-| first failure.
+| DESCRIPTION: The given number of plaintext files of different sizes are
+| encrypted by that many copies of OT7 started together in the background by
+| one shell command, all using the key file '123.key' and the new log file
+| 'par.log'. The copies take turns to encrypt a file, to encrypt a file read
+| from standard input and to encrypt a file with '-compress'.
 |
-| See the description of TestEncryptDecryptFile() for details.
+| Each copy runs in verbose mode and the range of key bytes it used is taken
+| from its status messages, from the first key byte where the key file
+| position is set to the last byte before the unused key bytes left. No two
+| ranges may overlap, and every record must decrypt to its plaintext.
 |
-| EXAMPLE: To test all files sizes from 1 to 3000 bytes, use this call:
+| This checks the locking of the log file and the reserving of key bytes in
+| it, see LockKeyUsageLogEntry() in OT7.c.
 |
-|   TestEncryptDecryptFiles_EncryptedFileFormatBase64( 1LL, 3000LL, 1LL ); 
+| If the test passes, then the working files are deleted. Otherwise they are
+| left on the disk and this test application exits.
+|
+| EXAMPLE: TestConcurrentEncryption( 12 );
+|
+| HISTORY:
+|    17Oct26
+------------------------------------------------------------------------------*/
+void
+TestConcurrentEncryption(
+    u32 ProcessCount )
+            // Number of copies of OT7 to run at once, from 2 to 16.
+{
+    s8  Command[4096];
+    s8  FileName[32];
+    u64 Start[16];
+    u64 End[16];
+    u64 KeyFileSize;
+    u64 UnusedCount;
+    u32 i, j;
+
+    // Print a dividing line between tests to make reading log files easier.
+    printf( "**************************************************************"
+            "******************\n" );
+
+    printf( "TestConcurrentEncryption for %lu processes.\n", ProcessCount );
+
+    // Delete any log files left from an earlier test.
+    remove( "par.log" );
+    remove( "par.log.bin" );
+
+    // Start with an empty command line.
+    Command[0] = 0;
+
+    // Make a plaintext file for each process and add the command that
+    // encrypts it in the background.
+    for( i = 0; i < ProcessCount; i++ )
+    {
+        // Generate a plaintext file with a different size for each process.
+        sprintf( FileName, "par%lu.bin", i );
+
+        if( GenerateRandomFile( FileName, 10000LL + i * 7919LL ) != RESULT_OK )
+        {
+            ExitOnFailedTest( "TestConcurrentEncryption",
+                              "Unable to generate plaintext file.",
+                              RESULT_CANT_WRITE_FILE );
+        }
+
+        // Add the command for this process, taking turns at the ways of
+        // reading the plaintext.
+        switch( i % 3 )
+        {
+            case 0:
+            {
+                sprintf( Command + strlen( Command ),
+                         "./ot7 -e par%lu.bin -oe par%lu.ot7 -KeyID 123 "
+                         "-logfile par.log -v > par%lu.txt & ",
+                         i, i, i );
+                break;
+            }
+            
+            case 1:
+            {
+                sprintf( Command + strlen( Command ),
+                         "./ot7 -e - -oe par%lu.ot7 -KeyID 123 "
+                         "-logfile par.log -v < par%lu.bin > par%lu.txt & ",
+                         i, i, i );
+                break;
+            }
+            
+            default:
+            {
+                sprintf( Command + strlen( Command ),
+                         "./ot7 -e par%lu.bin -oe par%lu.ot7 -KeyID 123 "
+                         "-compress -logfile par.log -v > par%lu.txt & ",
+                         i, i, i );
+                break;
+            }
+        }
+    }
+
+    // Wait for all of the processes to finish.
+    strcat( Command, "wait" );
+
+    // Run all of the processes at once.
+    Test( Command, RESULT_OK );
+
+    // Get the size of the key file.
+    KeyFileSize = GetFileSizeByName( "123.key" );
+
+    // Find the range of key bytes used by each process.
+    for( i = 0; i < ProcessCount; i++ )
+    {
+        sprintf( FileName, "par%lu.txt", i );
+
+        // If the process failed or its range can't be found, then fail.
+        if( ( IsStringInFile( FileName, "result code 0 = RESULT_OK" ) == 0 ) ||
+            ( ReadNumberAfterStringInFile( FileName,
+                                           "Set file position to ",
+                                           &Start[i] ) == 0 ) ||
+            ( ReadNumberAfterStringInFile( FileName,
+                                           "DONE: ",
+                                           &UnusedCount ) == 0 ) )
+        {
+            printf( "See '%s'.\n", FileName );
+            
+            ExitOnFailedTest( "TestConcurrentEncryption",
+                              "An encryption failed.",
+                              RESULT_INVALID_DECRYPTION_OUTPUT );
+        }
+
+        // The range ends where the unused key bytes begin.
+        End[i] = KeyFileSize - UnusedCount;
+    }
+
+    // If any two ranges overlap, then fail.
+    for( i = 0; i < ProcessCount; i++ )
+    {
+        for( j = i + 1; j < ProcessCount; j++ )
+        {
+            if( ( Start[i] < End[j] ) && ( Start[j] < End[i] ) )
+            {
+                printf( "Process %lu used key bytes %s to ",
+                        i, ConvertIntegerToString64( Start[i] ) );
+                printf( "%s, ", ConvertIntegerToString64( End[i] ) );
+                printf( "process %lu used %s to ",
+                        j, ConvertIntegerToString64( Start[j] ) );
+                printf( "%s.\n", ConvertIntegerToString64( End[j] ) );
+
+                ExitOnFailedTest( "TestConcurrentEncryption",
+                                  "Key bytes were used twice.",
+                                  RESULT_INVALID_DECRYPTION_OUTPUT );
+            }
+        }
+    }
+
+    // Decrypt each record and compare it to its plaintext.
+    for( i = 0; i < ProcessCount; i++ )
+    {
+        sprintf( Command,
+                 "./ot7 -d par%lu.ot7 -od decrypted.bin -KeyID 123 -silent",
+                 i );
+
+        Test( Command, RESULT_OK );
+
+        sprintf( FileName, "par%lu.bin", i );
+
+        if( IsFilesIdentical( FileName, "decrypted.bin" ) == 0 )
+        {
+            ExitOnFailedTest( "TestConcurrentEncryption",
+                              "Decrypted file does not match original "
+                              "plaintext.",
+                              RESULT_INVALID_DECRYPTION_OUTPUT );
+        }
+    }
+
+    // Delete the working files and the log files.
+    for( i = 0; i < ProcessCount; i++ )
+    {
+        sprintf( FileName, "par%lu.bin", i );
+        remove( FileName );
+        sprintf( FileName, "par%lu.ot7", i );
+        remove( FileName );
+        sprintf( FileName, "par%lu.txt", i );
+        remove( FileName );
+    }
+
+    remove( "decrypted.bin" );
+    remove( "par.log" );
+    remove( "par.log.bin" );
+
+    printf( "PASS: TestConcurrentEncryption for %lu processes.\n",
+            ProcessCount );
+}
+
+/*------------------------------------------------------------------------------
+| TestDamagedTaggedRecord
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test that damage to a tagged OT7 record is found at the chunk
+|          where it is, and that decryption can be resumed after the record
+|          is repaired.
+|
+| DESCRIPTION: A random plaintext file 'plain.bin' is encrypted to a tagged
+| record in 'encrypted.bin' with chunks of 4096 bytes, and one bit of the
+| encrypted file is changed at DamagedOffset, which should be in the chunks of
+| text.
+|
+| Decrypting the damaged record should stop with
+| RESULT_INVALID_CHECKSUM_DECRYPTED, leaving only the whole chunks before the
+| damage in 'decrypted.bin'. The bit is then changed back, and decryption with
+| '-resume' should keep the plaintext already decrypted and finish the rest.
+|
+| If the test passes, then the working files are deleted. Otherwise they are
+| left on the disk and this test application exits.
+|
+| EXAMPLE: TestDamagedTaggedRecord( 20000LL, 12000LL );
+|
+| HISTORY:
+|    17Oct26
+------------------------------------------------------------------------------*/
+void
+TestDamagedTaggedRecord(
+    u64 FileSize,
+            // Size of the plaintext file to make.
+            //
+    u64 DamagedOffset )
+            // Offset of the byte to change in the encrypted file.
+{
+    u64 DecryptedSize;
+
+    // Print a dividing line between tests to make reading log files easier.
+    printf( "**************************************************************"
+            "******************\n" );
+
+    printf( "TestDamagedTaggedRecord for file size %s.\n",
+            ConvertIntegerToString64( FileSize ) );
+
+    // Generate a plaintext file of the given size and filled with pseudo-random
+    // bytes.
+    if( GenerateRandomFile( "plain.bin", FileSize ) != RESULT_OK )
+    {
+        ExitOnFailedTest( "TestDamagedTaggedRecord",
+                          "Unable to generate plaintext file.",
+                          RESULT_CANT_WRITE_FILE );
+    }
+
+    // Encrypt 'plain.bin' to a tagged record in binary format.
+    Test( "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -tags -chunk 4096 "
+          "-binary -silent",
+          RESULT_OK );
+
+    // Damage the encrypted file.
+    if( FlipBitInFile( "encrypted.bin", DamagedOffset ) != RESULT_OK )
+    {
+        ExitOnFailedTest( "TestDamagedTaggedRecord",
+                          "Unable to change the encrypted file.",
+                          RESULT_CANT_WRITE_FILE );
+    }
+
+    // Decrypting the damaged record should fail at the damaged chunk.
+    Test( "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 -silent",
+          RESULT_INVALID_CHECKSUM_DECRYPTED );
+
+    // Get the number of plaintext bytes kept in the output file.
+    DecryptedSize = GetFileSizeByName( "decrypted.bin" );
+
+    // Only whole chunks that end before the damage should have been kept,
+    // and they should match the plaintext.
+    if( ( DecryptedSize == MAX_VALUE_64BIT ) ||
+        ( DecryptedSize % 4096 ) ||
+        ( DecryptedSize >= DamagedOffset ) ||
+        ( IsFileStartOfFile( "decrypted.bin", "plain.bin" ) == 0 ) )
+    {
+        ExitOnFailedTest( "TestDamagedTaggedRecord",
+                          "Output file wasn't cut back to the last good chunk.",
+                          RESULT_INVALID_DECRYPTION_OUTPUT );
+    }
+
+    printf( "Kept %s bytes decrypted before the damaged chunk.\n",
+            ConvertIntegerToString64( DecryptedSize ) );
+
+    // Repair the encrypted file.
+    if( FlipBitInFile( "encrypted.bin", DamagedOffset ) != RESULT_OK )
+    {
+        ExitOnFailedTest( "TestDamagedTaggedRecord",
+                          "Unable to change the encrypted file.",
+                          RESULT_CANT_WRITE_FILE );
+    }
+
+    // Resume decryption after the plaintext already in the output file.
+    Test( "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 -resume -silent",
+          RESULT_OK );
+
+    // If the decrypted file doesn't match the plaintext, then fail.
+    if( IsFilesIdentical( "plain.bin", "decrypted.bin" ) == 0 )
+    {
+        ExitOnFailedTest( "TestDamagedTaggedRecord",
+                          "Decrypted file does not match original plaintext.",
+                          RESULT_INVALID_DECRYPTION_OUTPUT );
+    }
+
+    // Delete the working files.
+    remove( "plain.bin" );
+    remove( "encrypted.bin" );
+    remove( "decrypted.bin" );
+
+    printf( "PASS: TestDamagedTaggedRecord for file size %s.\n",
+             ConvertIntegerToString64( FileSize ) );
+}
+
+/*------------------------------------------------------------------------------
+| TestDecryptRanges
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test decrypting parts of a record using the '-range' option.
+|
+| DESCRIPTION: A plaintext file 'plain.bin' of the given size is encrypted to
+| 'encrypted.bin' using the given command line, and then parts of it are
+| decrypted and compared to the same parts of the plaintext. The parts are:
+|
+|     - an empty part at the start,
+|     - the first byte,
+|     - parts crossing the boundaries of 4096-byte chunks and 64K buffers,
+|     - a part spanning several chunks,
+|     - a part running past the end, which should be cut off,
+|     - an empty part at the very end,
+|     - the whole plaintext.
+|
+| A part starting past the end of the plaintext should fail with
+| RESULT_RANGE_STARTS_PAST_END_OF_TEXT.
+|
+| The plaintext is made of pseudo-random bytes, or for compressed records of
+| blocks that can be compressed between blocks that can't, so that the parts
+| cross between compressed and stored blocks.
+|
+| If the test passes, then the working files are deleted. Otherwise they are
+| left on the disk and this test application exits.
+|
+| EXAMPLE:
+|
+|     TestDecryptRanges(
+|         "seekable",
+|         "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -seekable "
+|         "-chunk 4096 -silent",
+|         200000LL,
+|         0 );
+|
+| HISTORY:
+|    17Oct26
+------------------------------------------------------------------------------*/
+void
+TestDecryptRanges(
+    s8* RecordName,
+            // Name of the kind of record being tested, for the log.
+            //
+    s8* EncryptionCommandString,
+            // Command line that encrypts 'plain.bin' to 'encrypted.bin'.
+            //
+    u64 FileSize,
+            // Size of the plaintext file to make, more than 70000 bytes.
+            //
+    u32 IsCompressible )
+            // 1 if the plaintext should be compressible, or 0 if it should be
+            // pseudo-random.
+{
+    s8  Command[256];
+    u64 Ranges[10][2];
+    u64 Offset;
+    u64 ByteCount;
+    u32 Result;
+    u32 i;
+
+    // Print a dividing line between tests to make reading log files easier.
+    printf( "**************************************************************"
+            "******************\n" );
+
+    printf( "TestDecryptRanges for %s records of file size %s.\n",
+            RecordName,
+            ConvertIntegerToString64( FileSize ) );
+
+    // Generate the plaintext file.
+    if( IsCompressible )
+    {
+        Result = GenerateCompressibleFile( "plain.bin", FileSize );
+    }
+    else
+    {
+        Result = GenerateRandomFile( "plain.bin", FileSize );
+    }
+
+    // If the plaintext file couldn't be made, then fail.
+    if( Result != RESULT_OK )
+    {
+        ExitOnFailedTest( "TestDecryptRanges",
+                          "Unable to generate plaintext file.",
+                          RESULT_CANT_WRITE_FILE );
+    }
+
+    // Encrypt the plaintext.
+    Test( EncryptionCommandString, RESULT_OK );
+
+    // List the offset and size of each part to decrypt.
+    Ranges[0][0] = 0;                   Ranges[0][1] = 0;
+    Ranges[1][0] = 0;                   Ranges[1][1] = 1;
+    Ranges[2][0] = 4095;                Ranges[2][1] = 2;
+    Ranges[3][0] = 4096 * 3 - 10;       Ranges[3][1] = 4096 * 2 + 20;
+    Ranges[4][0] = 65530;               Ranges[4][1] = 12;
+    Ranges[5][0] = FileSize / 2;        Ranges[5][1] = 5000;
+    Ranges[6][0] = FileSize - 5;        Ranges[6][1] = 100;
+    Ranges[7][0] = FileSize;            Ranges[7][1] = 10;
+    Ranges[8][0] = 0;                   Ranges[8][1] = FileSize;
+    Ranges[9][0] = FileSize + 1;        Ranges[9][1] = 10;
+
+    // Decrypt each part in turn.
+    for( i = 0; i < 10; i++ )
+    {
+        // Get the offset and size of the part.
+        Offset = Ranges[i][0];
+        ByteCount = Ranges[i][1];
+
+        // Delete the output of the last part.
+        remove( "decrypted.bin" );
+
+        // Make the command line to decrypt the part.
+        strcpy( Command,
+                "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 "
+                "-range " );
+        strcat( Command, ConvertIntegerToString64( Offset ) );
+        strcat( Command, " " );
+        strcat( Command, ConvertIntegerToString64( ByteCount ) );
+        strcat( Command, " -silent" );
+
+        // If the part starts past the end of the plaintext, then decrypting
+        // it should fail.
+        if( Offset > FileSize )
+        {
+            Test( Command, RESULT_RANGE_STARTS_PAST_END_OF_TEXT );
+
+            continue;
+        }
+
+        // Decrypting the part should work.
+        Test( Command, RESULT_OK );
+
+        // Any part running past the end of the plaintext is cut off there.
+        if( ByteCount > FileSize - Offset )
+        {
+            ByteCount = FileSize - Offset;
+        }
+
+        // If the output doesn't match the part of the plaintext, then fail.
+        if( IsFilePartOfFile( "decrypted.bin",
+                              "plain.bin",
+                              Offset,
+                              ByteCount ) == 0 )
+        {
+            ExitOnFailedTest( "TestDecryptRanges",
+                              "Decrypted part does not match the plaintext.",
+                              RESULT_INVALID_DECRYPTION_OUTPUT );
+        }
+    }
+
+    // Delete the working files.
+    remove( "plain.bin" );
+    remove( "encrypted.bin" );
+    remove( "decrypted.bin" );
+
+    printf( "PASS: TestDecryptRanges for %s records of file size %s.\n",
+            RecordName,
+            ConvertIntegerToString64( FileSize ) );
+}
+
+/*------------------------------------------------------------------------------
+| TestEncryptDecryptFile
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test OT7 encryption and decryption for a file of a given size.
+|
+| DESCRIPTION: This routine generates a random plaintext file of a certain size,
+| then encrypts it, decrypts it, and compares the results.
+|
+| If the original plaintext file and the decrypted files match exactly, then the
+| working files are deleted and RESULT_OK is returned. Otherwise, the working 
+| files are left on the disk for later analysis and this test application exits
+| immediately, returning the error code from OT7.
+|
+| EXAMPLE: To test the encryption of a 5000 byte file using key file "123.key"
+| while suppressing output from OT7, use this call:
+|
+|    TestEncryptDecryptFile( 
+|       5000,
+|       "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -silent",
+|       "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 -silent" );
+|
+| Encryption and description command strings can be varied somewhat to test
+| various features, but the strings must begin as follows in order for this
+| routine to work:
+|
+| Encryption command prefix: "./ot7 -e plain.bin -oe encrypted.bin" ...
+| Decryption command prefix: "./ot7 -d encrypted.bin -od decrypted.bin" ...
+|
+| This routine generates a plaintext file named 'plain.bin'.
+|
+| The encrypted output file needs to be named 'encrypted.bin'.
+|
+| The file decrypted from 'encrypted.bin' is named 'decrypted.bin', and if
+| everything works as it should, then 'decrypted.bin' will be identical to
+| 'plain.bin'.
+|
+| HISTORY: 
+|    31Dec14
+------------------------------------------------------------------------------*/
+    // OUT: Result code RESULT_OK if successful, or application exit with an 
+int //      error code if not.
+TestEncryptDecryptFile( 
+    u64 FileSize,
+    s8* EncryptionCommandString,
+    s8* DecryptionCommandString )
+{
+    // Print a dividing line between tests to make reading log files easier.
+    printf( "**************************************************************"
+            "******************\n" );
+  
+    printf( "TestEncryptDecryptFile for file size %s.\n",
+            ConvertIntegerToString64( FileSize ) );
+
+    // Generate a plaintext file of the given size and filled with pseudo-random
+    // bytes.
+    //
+    // OUT: Result code RESULT_OK if successful, or an error code if not.
+    Result = GenerateRandomFile( "plain.bin", FileSize );
+    
+    // If unable to generate the plaintext file, then exit with the error code.
+    if( Result != RESULT_OK )
+    {
+        printf( "FAIL: TestEncryptDecryptFile for file size %s.\n",
+                 ConvertIntegerToString64( FileSize ) );
+         
+        printf( "      Unable to generate plaintext file.\n" );
+        
+        printf( "Exiting OT7 test program with result code %d = %s.\n", 
+                 Result,
+                 LookUpResultCodeString( Result ) );
+         
+        printf( "ENDING TEST EARLY ON FIRST FAILURE.\n" );
+  
+        // Exit from this test application, returning the result code from
+        // this test file.        
+        exit( Result );
+    }
+    
+    // Encrypt 'plain.bin' to file 'encrypted.bin' using KeyID 123 and key
+    // file '123.key'. Exits this application if result is not RESULT_OK.
+    Test( EncryptionCommandString, RESULT_OK );
+               
+    // Decrypt  'encrypted.bin' to 'decrypted.bin' using KeyID 123 and key
+    // file '123.key'. Exits this application if result is not RESULT_OK.
+    Test( DecryptionCommandString, RESULT_OK );
+    
+    // If the original generated plaintext file matches the decrypted file,
+    // then delete the working files and return RESULT_OK.
+    if( IsFilesIdentical( "plain.bin", "decrypted.bin" ) )
+    {
+        // Delete the generated plaintext file.
+        remove( "plain.bin" );
+        
+        // Delete the encrypted output file.
+        remove( "encrypted.bin" );
+        
+        // Delete the decrypted output file.
+        remove( "decrypted.bin" );
+        
+        printf( "PASS: TestEncryptDecryptFile for file size %s.\n",
+                 ConvertIntegerToString64( FileSize ) );
+    }
+    else // The files don't match.
+    {
+        printf( "FAIL: TestEncryptDecryptFile for file size %s.\n",
+                 ConvertIntegerToString64( FileSize ) );
+         
+        printf( "      Decrypted file does not match original plaintext.\n" );
+         
+        printf( "ENDING TEST EARLY ON FIRST FAILURE.\n" );
+  
+        // Exit from this test application, returning the result code from
+        // OT7.        
+        exit( RESULT_INVALID_DECRYPTION_OUTPUT );
+    }
+     
+    // Return RESULT_OK.
+    return( RESULT_OK );
+}
+
+/*------------------------------------------------------------------------------
+| TestEncryptDecryptFiles_DefaultOptions
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test encryption and decryption of a range of file sizes using
+|          key file '123.key' and default OT7 options, suppressing OT7 user
+|          message output with the '-silent' option.
+|
+| DESCRIPTION: Only returns from this routine if all tests pass, otherwise 
+| exiting on the first failure.
+|
+| See the description of TestEncryptDecryptFile() for details.
+|
+| EXAMPLE: To test all files sizes from 1 to 3000 bytes, use this call:
+|
+|   TestEncryptDecryptFiles_DefaultOptions( 1LL, 3000LL, 1LL ); 
+|
+| HISTORY:  
+|    31Dec14 
+------------------------------------------------------------------------------*/
+void
+TestEncryptDecryptFiles_DefaultOptions( 
+    u64 StartFileSize, 
+    u64 EndFileSize, 
+    u64 SizeIncrement )
+{
+    u64 FileSize;
+    
+    // Print a dividing line between tests to make reading log files easier.
+    printf( "@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@"
+            "@@@@@@@@@@@@@@@@@@\n" );
+  
+    printf( "TestEncryptDecryptFiles_DefaultOptions for file \n" );
+    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
+    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
+    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+      
+    // Test the encryption and decryption of all file sizes from the starting
+    // file size to the ending file size, stepping by the given increment.
+    for( FileSize  = StartFileSize; 
+         FileSize <= EndFileSize; 
+         FileSize += SizeIncrement )
+    {
+        // Generate a file of the current size, encrypt it, and decrypt it, 
+        // and compare the results.
+        //
+        // Returns if successful, or application exits with an error code if 
+        // not.
+        TestEncryptDecryptFile( 
+            FileSize,
+            "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -silent",
+            "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 -silent" );
+    }
+    
+    printf( "PASS: TestEncryptDecryptFiles_DefaultOptions for file \n" );
+    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
+    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
+    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+}
+
+/*------------------------------------------------------------------------------
+| TestEncryptDecryptFiles_EncryptedFileFormatBase64
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test encryption and decryption of a range of file sizes using key
+|          file '123.key', producing base64 output format for the encrypted
+|          files. 
+|
+| DESCRIPTION: Other OT7 options are defaults and OT7 user message output is 
+| suppressed with the '-silent' option.
+| 
+| Only returns from this routine if all tests pass, otherwise exiting on the 
+| first failure.
+|
+| See the description of TestEncryptDecryptFile() for details.
+|
+| EXAMPLE: To test all files sizes from 1 to 3000 bytes, use this call:
+|
+|   TestEncryptDecryptFiles_EncryptedFileFormatBase64( 1LL, 3000LL, 1LL ); 
+|
+| HISTORY:  
+|    31Dec14 
+------------------------------------------------------------------------------*/
+void
+TestEncryptDecryptFiles_EncryptedFileFormatBase64( 
+    u64 StartFileSize, 
+    u64 EndFileSize, 
+    u64 SizeIncrement )
+{
+    u64 FileSize;
+    
+    // Print a dividing line between tests to make reading log files easier.
+    printf( "@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@"
+            "@@@@@@@@@@@@@@@@@@\n" );
+  
+    printf( "TestEncryptDecryptFiles_EncryptedFileFormatBase64 for file \n" );
+    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
+    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
+    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+      
+    // Test the encryption and decryption of all file sizes from the starting
+    // file size to the ending file size, stepping by the given increment.
+    for( FileSize  = StartFileSize; 
+         FileSize <= EndFileSize; 
+         FileSize += SizeIncrement )
+    {
+        // Generate a file of the current size, encrypt it, and decrypt it, 
+        // and compare the results.
+        //
+        // Returns if successful, or application exits with an error code if 
+        // not.
+        TestEncryptDecryptFile( 
+            FileSize,
+            "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -base64 -silent",
+            "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 -base64 -silent" );
+    }
+    
+    printf( "PASS: TestEncryptDecryptFiles_EncryptedFileFormatBase64 for file \n" );
+    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
+    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
+    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+}
+
+/*------------------------------------------------------------------------------
+| TestEncryptDecryptFiles_EncryptedFileFormatBinary
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test encryption and decryption of a range of file sizes using key
+|          file '123.key', producing binary output format for the encrypted
+|          files. 
+|
+| DESCRIPTION: Other OT7 options are defaults and OT7 user message output is 
+| suppressed with the '-silent' option.
+| 
+| Only returns from this routine if all tests pass, otherwise exiting on the 
+| first failure.
+|
+| See the description of TestEncryptDecryptFile() for details.
+|
+| EXAMPLE: To test all files sizes from 1 to 3000 bytes, use this call:
+|
+|   TestEncryptDecryptFiles_EncryptedFileFormatBinary( 1LL, 3000LL, 1LL ); 
+|
+| HISTORY:  
+|    31Dec14 
+------------------------------------------------------------------------------*/
+void
+TestEncryptDecryptFiles_EncryptedFileFormatBinary( 
+    u64 StartFileSize, 
+    u64 EndFileSize, 
+    u64 SizeIncrement )
+{
+    u64 FileSize;
+    
+    // Print a dividing line between tests to make reading log files easier.
+    printf( "@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@"
+            "@@@@@@@@@@@@@@@@@@\n" );
+  
+    printf( "TestEncryptDecryptFiles_EncryptedFileFormatBinary for file \n" );
+    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
+    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
+    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+      
+    // Test the encryption and decryption of all file sizes from the starting
+    // file size to the ending file size, stepping by the given increment.
+    for( FileSize  = StartFileSize; 
+         FileSize <= EndFileSize; 
+         FileSize += SizeIncrement )
+    {
+        // Generate a file of the current size, encrypt it, and decrypt it, 
+        // and compare the results.
+        //
+        // Returns if successful, or application exits with an error code if 
+        // not.
+        TestEncryptDecryptFile( 
+            FileSize,
+            "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -binary -silent",
+            "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 -binary -silent" );
+    }
+    
+    printf( "PASS: TestEncryptDecryptFiles_EncryptedFileFormatBinary for file \n" );
+    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
+    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
+    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+}
+
+/*------------------------------------------------------------------------------
+| TestEncryptDecryptFiles_Compressed
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test encryption and decryption of a range of file sizes using key
+|          file '123.key', making compressed OT7 records.
+|
+| DESCRIPTION: The plaintext is random data that can't be compressed, so each
+| chunk of 4096 bytes is stored without compression. Other OT7 options are 
+| defaults and OT7 user message output is suppressed with the '-silent' 
+| option.
+|
+| Only returns from this routine if all tests pass, otherwise exiting on the
+| first failure.
+|
+| See the description of TestEncryptDecryptFile() for details.
+|
+| EXAMPLE: To test all files sizes from 0 to 3000 bytes, use this call:
+|
+|   TestEncryptDecryptFiles_Compressed( 0LL, 3000LL, 1LL );
+|
+| HISTORY:
+|    17Oct26 From TestEncryptDecryptFiles_NoFileName().
+------------------------------------------------------------------------------*/
+void
+TestEncryptDecryptFiles_Compressed(
+    u64 StartFileSize,
+    u64 EndFileSize,
+    u64 SizeIncrement )
+{
+    u64 FileSize;
+
+    // Print a dividing line between tests to make reading log files easier.
+    printf( "@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@"
+            "@@@@@@@@@@@@@@@@@@\n" );
+
+    printf( "TestEncryptDecryptFiles_Compressed for file \n" );
+    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
+    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
+    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+
+    // Test the encryption and decryption of all file sizes from the starting
+    // file size to the ending file size, stepping by the given increment.
+    for( FileSize  = StartFileSize;
+         FileSize <= EndFileSize;
+         FileSize += SizeIncrement )
+    {
+        // Generate a file of the current size, encrypt it, and decrypt it,
+        // and compare the results.
+        //
+        // Returns if successful, or application exits with an error code if
+        // not.
+        TestEncryptDecryptFile(
+            FileSize,
+            "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -compress "
+            "-chunk 4096 -silent",
+            "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 -silent" );
+    }
+
+    printf( "PASS: TestEncryptDecryptFiles_Compressed for file \n" );
+    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
+    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
+    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+}
+
+/*------------------------------------------------------------------------------
+| TestEncryptDecryptFiles_FillPolicy
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test encryption and decryption of a range of file sizes using key
+|          file '123.key' and a given '-fillpolicy' option.
+|
+| DESCRIPTION: FillPolicy is the value of the '-fillpolicy' option, either
+| 'bucket' or a percentage such as '5%'. Other OT7 options are defaults and
+| OT7 user message output is suppressed with the '-silent' option.
+|
+| Only returns from this routine if all tests pass, otherwise exiting on the
+| first failure.
+|
+| See the description of TestEncryptDecryptFile() for details.
+|
+| EXAMPLE: To test all files sizes from 0 to 3000 bytes with fill of up to 5%
+| of the plaintext size, use this call:
+|
+|   TestEncryptDecryptFiles_FillPolicy( 0LL, 3000LL, 1LL, "5%" );
+|
+| HISTORY:
+|    17Oct26 From TestEncryptDecryptFiles_NoFileName().
+------------------------------------------------------------------------------*/
+void
+TestEncryptDecryptFiles_FillPolicy(
+    u64 StartFileSize,
+    u64 EndFileSize,
+    u64 SizeIncrement,
+    s8* FillPolicy )
+{
+    u64 FileSize;
+    s8  EncryptCommand[256];
+
+    // Print a dividing line between tests to make reading log files easier.
+    printf( "@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@"
+            "@@@@@@@@@@@@@@@@@@\n" );
+
+    printf( "TestEncryptDecryptFiles_FillPolicy '%s' for file \n", FillPolicy );
+    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
+    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
+    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+
+    // Make the encryption command using the given fill policy.
+    sprintf( EncryptCommand,
+             "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 "
+             "-fillpolicy %s -silent",
+             FillPolicy );
+
+    // Test the encryption and decryption of all file sizes from the starting
+    // file size to the ending file size, stepping by the given increment.
+    for( FileSize  = StartFileSize;
+         FileSize <= EndFileSize;
+         FileSize += SizeIncrement )
+    {
+        // Generate a file of the current size, encrypt it, and decrypt it,
+        // and compare the results.
+        //
+        // Returns if successful, or application exits with an error code if
+        // not.
+        TestEncryptDecryptFile(
+            FileSize,
+            EncryptCommand,
+            "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 -silent" );
+    }
+
+    printf( "PASS: TestEncryptDecryptFiles_FillPolicy '%s' for file \n",
+            FillPolicy );
+    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
+    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
+    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+}
+
+/*------------------------------------------------------------------------------
+| TestEncryptDecryptFiles_NoFileName
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test encryption and decryption of a range of file sizes using key
+|          file '123.key', producing an OT7 record without an embedded file 
+|          name.
+|
+| DESCRIPTION: Other OT7 options are defaults and OT7 user message output is 
+| suppressed with the '-silent' option.
+| 
+| Only returns from this routine if all tests pass, otherwise exiting on the 
+| first failure.
+|
+| See the description of TestEncryptDecryptFile() for details.
+|
+| EXAMPLE: To test all files sizes from 1 to 3000 bytes, use this call:
+|
+|   TestEncryptDecryptFiles_NoFileName( 1LL, 3000LL, 1LL ); 
 |
 | HISTORY:  
 |    31Dec14 
 ------------------------------------------------------------------------------*/
 void
-TestEncryptDecryptFiles_EncryptedFileFormatBase64( 
-    u64 StartFileSize, 
-    u64 EndFileSize, 
-    u64 SizeIncrement )
+TestEncryptDecryptFiles_NoFileName( 
+    u64 StartFileSize, 
+    u64 EndFileSize, 
+    u64 SizeIncrement )
+{
+    u64 FileSize;
+    
+    // Print a dividing line between tests to make reading log files easier.
+    printf( "@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@"
+            "@@@@@@@@@@@@@@@@@@\n" );
+  
+    printf( "TestEncryptDecryptFiles_NoFileName for file \n" );
+    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
+    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
+    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+      
+    // Test the encryption and decryption of all file sizes from the starting
+    // file size to the ending file size, stepping by the given increment.
+    for( FileSize  = StartFileSize; 
+         FileSize <= EndFileSize; 
+         FileSize += SizeIncrement )
+    {
+        // Generate a file of the current size, encrypt it, and decrypt it, 
+        // and compare the results.
+        //
+        // Returns if successful, or application exits with an error code if 
+        // not.
+        TestEncryptDecryptFile( 
+            FileSize,
+            "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -nofilename -silent",
+            "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 -silent" );
+    }
+    
+    printf( "PASS: TestEncryptDecryptFiles_NoFileName for file \n" );
+    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
+    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
+    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+}
+
+/*------------------------------------------------------------------------------
+| TestEncryptDecryptFiles_StandardStreams
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test encryption and decryption of a range of file sizes using key
+|          file '123.key', reading the plaintext from standard input and
+|          writing the OT7 record to standard output.
+|
+| DESCRIPTION: The shell redirects 'plain.bin' to standard input, so OT7 can
+| find the size of the plaintext even though it makes a streamed record.
+| Other OT7 options are defaults and OT7 user message output is suppressed
+| with the '-silent' option.
+|
+| Only returns from this routine if all tests pass, otherwise exiting on the
+| first failure.
+|
+| See the description of TestEncryptDecryptFile() for details.
+|
+| EXAMPLE: To test all files sizes from 0 to 3000 bytes, use this call:
+|
+|   TestEncryptDecryptFiles_StandardStreams( 0LL, 3000LL, 1LL );
+|
+| HISTORY:
+|    17Oct26 From TestEncryptDecryptFiles_NoFileName().
+------------------------------------------------------------------------------*/
+void
+TestEncryptDecryptFiles_StandardStreams(
+    u64 StartFileSize,
+    u64 EndFileSize,
+    u64 SizeIncrement )
+{
+    u64 FileSize;
+
+    // Print a dividing line between tests to make reading log files easier.
+    printf( "@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@"
+            "@@@@@@@@@@@@@@@@@@\n" );
+
+    printf( "TestEncryptDecryptFiles_StandardStreams for file \n" );
+    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
+    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
+    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+
+    // Test the encryption and decryption of all file sizes from the starting
+    // file size to the ending file size, stepping by the given increment.
+    for( FileSize  = StartFileSize;
+         FileSize <= EndFileSize;
+         FileSize += SizeIncrement )
+    {
+        // Generate a file of the current size, encrypt it, and decrypt it,
+        // and compare the results.
+        //
+        // Returns if successful, or application exits with an error code if
+        // not.
+        TestEncryptDecryptFile(
+            FileSize,
+            "./ot7 -e - -oe - -KeyID 123 -silent < plain.bin > encrypted.bin",
+            "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 -silent" );
+    }
+
+    printf( "PASS: TestEncryptDecryptFiles_StandardStreams for file \n" );
+    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
+    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
+    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+}
+
+/*------------------------------------------------------------------------------
+| TestEncryptDecryptFiles_Streamed
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test encryption and decryption of a range of file sizes using key
+|          file '123.key', making streamed OT7 records from plaintext piped to
+|          standard input.
+|
+| DESCRIPTION: The size of piped plaintext isn't known until all of it has
+| been read, so key bytes are reserved as they are needed. Chunks of 4096
+| bytes are used so that files of a few thousand bytes are split into several
+| chunks. Other OT7 options are defaults and OT7 user message output is
+| suppressed with the '-silent' option.
+|
+| Only returns from this routine if all tests pass, otherwise exiting on the
+| first failure.
+|
+| See the description of TestEncryptDecryptFile() for details.
+|
+| EXAMPLE: To test all files sizes from 0 to 3000 bytes, use this call:
+|
+|   TestEncryptDecryptFiles_Streamed( 0LL, 3000LL, 1LL );
+|
+| HISTORY:
+|    17Oct26 From TestEncryptDecryptFiles_NoFileName().
+------------------------------------------------------------------------------*/
+void
+TestEncryptDecryptFiles_Streamed(
+    u64 StartFileSize,
+    u64 EndFileSize,
+    u64 SizeIncrement )
+{
+    u64 FileSize;
+
+    // Print a dividing line between tests to make reading log files easier.
+    printf( "@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@"
+            "@@@@@@@@@@@@@@@@@@\n" );
+
+    printf( "TestEncryptDecryptFiles_Streamed for file \n" );
+    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
+    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
+    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+
+    // Test the encryption and decryption of all file sizes from the starting
+    // file size to the ending file size, stepping by the given increment.
+    for( FileSize  = StartFileSize;
+         FileSize <= EndFileSize;
+         FileSize += SizeIncrement )
+    {
+        // Generate a file of the current size, encrypt it, and decrypt it,
+        // and compare the results.
+        //
+        // Returns if successful, or application exits with an error code if
+        // not.
+        TestEncryptDecryptFile(
+            FileSize,
+            "cat plain.bin | "
+            "./ot7 -e - -oe encrypted.bin -KeyID 123 -chunk 4096 -silent",
+            "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 -silent" );
+    }
+
+    printf( "PASS: TestEncryptDecryptFiles_Streamed for file \n" );
+    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
+    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
+    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+}
+
+/*------------------------------------------------------------------------------
+| TestEncryptDecryptFiles_Tagged
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test encryption and decryption of a range of file sizes using key
+|          file '123.key', making tagged OT7 records.
+|
+| DESCRIPTION: Chunks of 4096 bytes are used so that files of a few thousand
+| bytes are split into several chunks, each with its own ChunkTag. Other OT7
+| options are defaults and OT7 user message output is suppressed with the
+| '-silent' option.
+|
+| Only returns from this routine if all tests pass, otherwise exiting on the
+| first failure.
+|
+| See the description of TestEncryptDecryptFile() for details.
+|
+| EXAMPLE: To test all files sizes from 0 to 3000 bytes, use this call:
+|
+|   TestEncryptDecryptFiles_Tagged( 0LL, 3000LL, 1LL );
+|
+| HISTORY:
+|    17Oct26 From TestEncryptDecryptFiles_NoFileName().
+------------------------------------------------------------------------------*/
+void
+TestEncryptDecryptFiles_Tagged(
+    u64 StartFileSize,
+    u64 EndFileSize,
+    u64 SizeIncrement )
+{
+    u64 FileSize;
+
+    // Print a dividing line between tests to make reading log files easier.
+    printf( "@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@"
+            "@@@@@@@@@@@@@@@@@@\n" );
+
+    printf( "TestEncryptDecryptFiles_Tagged for file \n" );
+    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
+    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
+    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+
+    // Test the encryption and decryption of all file sizes from the starting
+    // file size to the ending file size, stepping by the given increment.
+    for( FileSize  = StartFileSize;
+         FileSize <= EndFileSize;
+         FileSize += SizeIncrement )
+    {
+        // Generate a file of the current size, encrypt it, and decrypt it,
+        // and compare the results.
+        //
+        // Returns if successful, or application exits with an error code if
+        // not.
+        TestEncryptDecryptFile(
+            FileSize,
+            "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -tags -chunk 4096 "
+            "-silent",
+            "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 -silent" );
+    }
+
+    printf( "PASS: TestEncryptDecryptFiles_Tagged for file \n" );
+    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
+    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
+    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+}
+
+/*------------------------------------------------------------------------------
+| TestKeyMapCache
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test that a key map cache which no longer matches its key map
+|          file isn't used.
+|
+| DESCRIPTION: A 'key.map' file defining KeyID 5 with the key file 'mapA.key'
+| is used to encrypt 'plain.bin', which writes the cache 'key.map.idx', and
+| encrypting again should use the cache.
+|
+| Then 'key.map' is rewritten to use 'mapB.key' instead, which leaves its size
+| the same, and its modification time is set back to what it was. Encrypting
+| should notice that the cache is stale, use 'mapB.key' and write a new cache,
+| which the next encryption should use. The record is then decrypted using the
+| key map and compared to the plaintext.
+|
+| If the test passes, then the working files are deleted. Otherwise they are
+| left on the disk and this test application exits.
+|
+| EXAMPLE: TestKeyMapCache();
+|
+| HISTORY:
+|    17Oct26
+------------------------------------------------------------------------------*/
+void
+TestKeyMapCache()
+{
+    // Print a dividing line between tests to make reading log files easier.
+    printf( "**************************************************************"
+            "******************\n" );
+
+    printf( "TestKeyMapCache.\n" );
+
+    // Delete any files left from an earlier test.
+    remove( "key.map" );
+    remove( "key.map.idx" );
+    remove( "keymap.log" );
+    remove( "keymap.log.bin" );
+
+    // Generate the key files and a plaintext file.
+    if( ( GenerateRandomFile( "mapA.key", 100000LL ) != RESULT_OK ) ||
+        ( GenerateRandomFile( "mapB.key", 100000LL ) != RESULT_OK ) ||
+        ( GenerateRandomFile( "plain.bin", 3000LL ) != RESULT_OK ) )
+    {
+        ExitOnFailedTest( "TestKeyMapCache",
+                          "Unable to generate key files and plaintext file.",
+                          RESULT_CANT_WRITE_FILE );
+    }
+
+    // Make a key map using 'mapA.key'.
+    Test( "printf 'KeyID( 5 )\\n{\\n-keyfile mapA.key\\n-ID alpha\\n}\\n' "
+          "> key.map",
+          RESULT_OK );
+
+    // Encrypting should write the cache.
+    Test( "./ot7 -e plain.bin -oe encrypted.bin -ID alpha -logfile keymap.log "
+          "-v > keymap.txt",
+          RESULT_OK );
+
+    if( IsStringInFile( "keymap.txt", "Wrote key map cache" ) == 0 )
+    {
+        ExitOnFailedTest( "TestKeyMapCache",
+                          "The key map cache wasn't written.",
+                          RESULT_CANT_WRITE_FILE );
+    }
+
+    // Encrypting again should use the cache.
+    Test( "./ot7 -e plain.bin -oe encrypted.bin -ID alpha -logfile keymap.log "
+          "-v > keymap.txt",
+          RESULT_OK );
+
+    if( IsStringInFile( "keymap.txt", "Using key map cache" ) == 0 )
+    {
+        ExitOnFailedTest( "TestKeyMapCache",
+                          "The key map cache wasn't used.",
+                          RESULT_CANT_READ_KEY_MAP_FILE );
+    }
+
+    // Change the key map to use 'mapB.key', keeping its size and modification
+    // time the same.
+    Test( "touch -r key.map keymap.time", RESULT_OK );
+
+    Test( "printf 'KeyID( 5 )\\n{\\n-keyfile mapB.key\\n-ID alpha\\n}\\n' "
+          "> key.map",
+          RESULT_OK );
+
+    Test( "touch -r keymap.time key.map", RESULT_OK );
+
+    // Encrypting should find that the cache is stale and rebuild it.
+    Test( "./ot7 -e plain.bin -oe encrypted.bin -ID alpha -logfile keymap.log "
+          "-v > keymap.txt",
+          RESULT_OK );
+
+    if( IsStringInFile( "keymap.txt", "Using key map cache" ) ||
+        ( IsStringInFile( "keymap.txt", "Wrote key map cache" ) == 0 ) ||
+        ( IsStringInFile( "keymap.txt", "mapB.key" ) == 0 ) )
+    {
+        ExitOnFailedTest( "TestKeyMapCache",
+                          "The stale key map cache was used.",
+                          RESULT_CANT_READ_KEY_MAP_FILE );
+    }
+
+    // Encrypting again should use the new cache and the new key file.
+    Test( "./ot7 -e plain.bin -oe encrypted.bin -ID alpha -logfile keymap.log "
+          "-v > keymap.txt",
+          RESULT_OK );
+
+    if( ( IsStringInFile( "keymap.txt", "Using key map cache" ) == 0 ) ||
+        ( IsStringInFile( "keymap.txt", "mapB.key" ) == 0 ) )
+    {
+        ExitOnFailedTest( "TestKeyMapCache",
+                          "The rebuilt key map cache wasn't used.",
+                          RESULT_CANT_READ_KEY_MAP_FILE );
+    }
+
+    // Decrypt the record using the key map and compare it to the plaintext.
+    Test( "./ot7 -d encrypted.bin -od decrypted.bin -silent", RESULT_OK );
+
+    if( IsFilesIdentical( "plain.bin", "decrypted.bin" ) == 0 )
+    {
+        ExitOnFailedTest( "TestKeyMapCache",
+                          "Decrypted file does not match original plaintext.",
+                          RESULT_INVALID_DECRYPTION_OUTPUT );
+    }
+
+    // Delete the working files, leaving no key map for the tests that follow.
+    remove( "plain.bin" );
+    remove( "encrypted.bin" );
+    remove( "decrypted.bin" );
+    remove( "mapA.key" );
+    remove( "mapB.key" );
+    remove( "key.map" );
+    remove( "key.map.idx" );
+    remove( "keymap.txt" );
+    remove( "keymap.time" );
+    remove( "keymap.log" );
+    remove( "keymap.log.bin" );
+
+    printf( "PASS: TestKeyMapCache.\n" );
+}
+
+/*------------------------------------------------------------------------------
+| TestKeyMapIdentifiers
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test how key definitions are looked up by identifier.
+|
+| DESCRIPTION: A 'key.map' file is made with three key definitions, each with
+| its own key file:
+|
+|     KeyID 6 - 'mapA.key', identifier 'Dan Jones Sr'
+|     KeyID 7 - 'mapB.key', identifiers 'Dan Jones' and 'dan@mail.net'
+|     KeyID 8 - 'mapC.key', identifier 'Jones'
+|
+| An identifier that a definition has exactly should select that definition,
+| even when an earlier definition has an identifier that contains it. Any
+| other identifier should select the first definition with an identifier that
+| contains it, and an identifier that no definition contains shouldn't select
+| any definition.
+|
+| Each look up is done twice, first parsing the key map and then using the
+| key map cache, and should select the same definition both times.
+|
+| If the test passes, then the working files are deleted. Otherwise they are
+| left on the disk and this test application exits.
+|
+| EXAMPLE: TestKeyMapIdentifiers();
+|
+| HISTORY:
+|    17Oct26
+------------------------------------------------------------------------------*/
+void
+TestKeyMapIdentifiers()
+{
+    u32 IsCached;
+
+    // Print a dividing line between tests to make reading log files easier.
+    printf( "**************************************************************"
+            "******************\n" );
+
+    printf( "TestKeyMapIdentifiers.\n" );
+
+    // Delete any log files left from an earlier test.
+    remove( "keymap.log" );
+    remove( "keymap.log.bin" );
+
+    // Generate the key files and a plaintext file.
+    if( ( GenerateRandomFile( "mapA.key", 100000LL ) != RESULT_OK ) ||
+        ( GenerateRandomFile( "mapB.key", 100000LL ) != RESULT_OK ) ||
+        ( GenerateRandomFile( "mapC.key", 100000LL ) != RESULT_OK ) ||
+        ( GenerateRandomFile( "plain.bin", 3000LL ) != RESULT_OK ) )
+    {
+        ExitOnFailedTest( "TestKeyMapIdentifiers",
+                          "Unable to generate key files and plaintext file.",
+                          RESULT_CANT_WRITE_FILE );
+    }
+
+    // Make the key map.
+    Test( "printf 'KeyID( 6 )\\n{\\n-keyfile mapA.key\\n"
+          "-ID \"Dan Jones Sr\"\\n}\\n"
+          "KeyID( 7 )\\n{\\n-keyfile mapB.key\\n"
+          "-ID \"Dan Jones\"\\n-ID dan@mail.net\\n}\\n"
+          "KeyID( 8 )\\n{\\n-keyfile mapC.key\\n-ID Jones\\n}\\n' "
+          "> key.map",
+          RESULT_OK );
+
+    // Do each look up first without the cache and then with it.
+    for( IsCached = 0; IsCached < 2; IsCached++ )
+    {
+        // Exact identifiers select their own definitions.
+        TestKeyMapLookUp( "-ID \"Dan Jones\"", "mapB.key", IsCached );
+        TestKeyMapLookUp( "-ID Jones", "mapC.key", IsCached );
+        TestKeyMapLookUp( "-ID dan@mail.net", "mapB.key", IsCached );
+
+        // Other identifiers select the first definition containing them.
+        TestKeyMapLookUp( "-ID Sr", "mapA.key", IsCached );
+        TestKeyMapLookUp( "-ID Dan", "mapA.key", IsCached );
+        TestKeyMapLookUp( "-ID mail.net", "mapB.key", IsCached );
+
+        // An exact match for any of several identifiers comes first.
+        TestKeyMapLookUp( "-ID Sr -ID Jones", "mapC.key", IsCached );
+        TestKeyMapLookUp( "-ID nobody -ID dan@mail.net", "mapB.key", IsCached );
+
+        // An identifier that isn't in the key map selects no definition.
+        TestKeyMapLookUp( "-ID nobody", 0, IsCached );
+
+        // Look ups by KeyID use the index too.
+        TestKeyMapLookUp( "-KeyID 6", "mapA.key", IsCached );
+        TestKeyMapLookUp( "-KeyID 8", "mapC.key", IsCached );
+    }
+
+    // Delete the working files, leaving no key map for the tests that follow.
+    remove( "plain.bin" );
+    remove( "encrypted.bin" );
+    remove( "mapA.key" );
+    remove( "mapB.key" );
+    remove( "mapC.key" );
+    remove( "key.map" );
+    remove( "key.map.idx" );
+    remove( "keymap.txt" );
+    remove( "keymap.log" );
+    remove( "keymap.log.bin" );
+
+    printf( "PASS: TestKeyMapIdentifiers.\n" );
+}
+
+/*------------------------------------------------------------------------------
+| TestKeyMapLookUp
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test which key definition of 'key.map' is selected by the
+|          given options.
+|
+| DESCRIPTION: 'plain.bin' is encrypted in verbose mode using the options, and
+| the output is checked to see which key file was opened and whether the key
+| map cache was used.
+|
+| If the test fails, then this test application exits.
+|
+| EXAMPLE: TestKeyMapLookUp( "-ID Jones", "mapC.key", 0 );
+|
+| HISTORY:
+|    17Oct26
+------------------------------------------------------------------------------*/
+void
+TestKeyMapLookUp(
+    s8* Options,
+            // The options that select a key definition, eg. "-ID Jones".
+            //
+    s8* KeyFileName,
+            // The key file of the key definition that should be selected, or
+            // 0 if no key definition should be selected.
+            //
+    u32 IsCached )
+            // 1 if the key map cache should be used, or 0 if it should be
+            // deleted first so that the key map is parsed.
+{
+    s8 Command[256];
+    s8 Message[128];
+
+    // If the key map should be parsed, then delete the cache.
+    if( IsCached == 0 )
+    {
+        remove( "key.map.idx" );
+    }
+
+    // Make the command line.
+    sprintf( Command,
+             "./ot7 -e plain.bin -oe encrypted.bin %s -logfile keymap.log "
+             "-v > keymap.txt",
+             Options );
+
+    // If no key definition should be selected, then the default key file
+    // '0.key' should be looked for and not found.
+    if( KeyFileName == 0 )
+    {
+        Test( Command, RESULT_CANT_OPEN_KEY_FILE_FOR_READING );
+    }
+    else // The key file of the definition should be used.
+    {
+        Test( Command, RESULT_OK );
+
+        // Make the message printed when the key file is opened.
+        sprintf( Message, "Opened key file '%s'", KeyFileName );
+
+        // If another key file was used, then fail.
+        if( IsStringInFile( "keymap.txt", Message ) == 0 )
+        {
+            printf( "Options: %s\n", Options );
+
+            ExitOnFailedTest( "TestKeyMapLookUp",
+                              "The wrong key definition was selected.",
+                              RESULT_CANT_IDENTIFY_KEYID_FOR_ENCRYPTION );
+        }
+    }
+
+    // If the cache wasn't used or written as expected, then fail.
+    if( IsStringInFile( "keymap.txt",
+                        IsCached ? "Using key map cache" :
+                                   "Wrote key map cache" ) == 0 )
+    {
+        printf( "Options: %s\n", Options );
+
+        ExitOnFailedTest( "TestKeyMapLookUp",
+                          IsCached ? "The key map cache wasn't used." :
+                                     "The key map cache wasn't written.",
+                          RESULT_CANT_READ_KEY_MAP_FILE );
+    }
+}
+
+/*------------------------------------------------------------------------------
+| TestLogExportImport
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test that the key bytes used are kept when a log file is
+|          exported to text, imported again, or converted from the older text
+|          format.
+|
+| DESCRIPTION: A random plaintext file 'plain.bin' is encrypted using a new log
+| file 'test.log', and that log is exported to the text file 'old.log', which
+| has the same format as the log files made by older versions of OT7. A copy
+| of it is also kept as 'exported.txt'.
+|
+| The plaintext is then encrypted three more times:
+|
+|   1. Using 'test.log'.
+|   2. Using 'old.log', which is converted to the current format when opened.
+|   3. Using a new log file 'import.log' after importing 'exported.txt'.
+|
+| All three logs hold the same key usage, so the same key bytes are used and
+| the three records should be identical. They should also differ from the
+| first record, because the key bytes used by it were logged.
+|
+| If the test passes, then the working files are deleted. Otherwise they are
+| left on the disk and this test application exits.
+|
+| EXAMPLE: TestLogExportImport( 3000LL );
+|
+| HISTORY:
+|    17Oct26
+------------------------------------------------------------------------------*/
+void
+TestLogExportImport( u64 FileSize )
 {
-    u64 FileSize;
-    
     // Print a dividing line between tests to make reading log files easier.
-    printf( "@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@"
-            "@@@@@@@@@@@@@@@@@@\n" );
-  
-    printf( "TestEncryptDecryptFiles_EncryptedFileFormatBase64 for file \n" );
-    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
-    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
-    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
-      
-    // Test the encryption and decryption of all file sizes from the starting
-    // file size to the ending file size, stepping by the given increment.
-    for( FileSize  = StartFileSize; 
-         FileSize <= EndFileSize; 
-         FileSize += SizeIncrement )
+    printf( "**************************************************************"
+            "******************\n" );
+
+    printf( "TestLogExportImport for file size %s.\n",
+            ConvertIntegerToString64( FileSize ) );
+
+    // Delete any log files left from an earlier test.
+    remove( "test.log" );
+    remove( "test.log.bin" );
+    remove( "old.log" );
+    remove( "old.log.bin" );
+    remove( "import.log" );
+    remove( "import.log.bin" );
+
+    // Generate a plaintext file of the given size and filled with pseudo-random
+    // bytes.
+    if( GenerateRandomFile( "plain.bin", FileSize ) != RESULT_OK )
     {
-        // Generate a file of the current size, encrypt it, and decrypt it, 
-        // and compare the results.
-        //
-        // Returns if successful, or application exits with an error code if 
-        // not.
-        TestEncryptDecryptFile( 
-            FileSize,
-            "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -base64 -silent",
-            "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 -base64 -silent" );
+        ExitOnFailedTest( "TestLogExportImport",
+                          "Unable to generate plaintext file.",
+                          RESULT_CANT_WRITE_FILE );
     }
-    
-    printf( "PASS: TestEncryptDecryptFiles_EncryptedFileFormatBase64 for file \n" );
-    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
-    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
-    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+
+    // Encrypt the plaintext using a new log file.
+    Test( "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -logfile test.log "
+          "-binary -silent",
+          RESULT_OK );
+
+    // Export the log file to text.
+    Test( "./ot7 -logfile test.log -exportlog old.log -silent", RESULT_OK );
+
+    // Keep a copy of the exported text to import later.
+    Test( "cp old.log exported.txt", RESULT_OK );
+
+    // Encrypt the plaintext using each of the log files.
+    Test( "./ot7 -e plain.bin -oe encryptedA.bin -KeyID 123 -logfile test.log "
+          "-binary -silent",
+          RESULT_OK );
+
+    Test( "./ot7 -e plain.bin -oe encryptedB.bin -KeyID 123 -logfile old.log "
+          "-binary -silent",
+          RESULT_OK );
+
+    // The converted text log should now mark its key file as used up so 
+    // that older versions of OT7 won't use it, see KEY_USAGE_LOG_TEXT_USED_UP
+    // in OT7.c.
+    if( IsStringInFile( "old.log", "18446744073709551615" ) == 0 )
+    {
+        ExitOnFailedTest( "TestLogExportImport",
+                          "Text log file was not converted.",
+                          RESULT_INVALID_DECRYPTION_OUTPUT );
+    }
+
+    // Import the exported text into a new log file, and encrypt using it.
+    Test( "./ot7 -logfile import.log -importlog exported.txt -silent",
+          RESULT_OK );
+
+    Test( "./ot7 -e plain.bin -oe encryptedC.bin -KeyID 123 "
+          "-logfile import.log -binary -silent",
+          RESULT_OK );
+
+    // If the last three records aren't the same, then fail.
+    if( ( IsFilesIdentical( "encryptedA.bin", "encryptedB.bin" ) == 0 ) ||
+        ( IsFilesIdentical( "encryptedA.bin", "encryptedC.bin" ) == 0 ) )
+    {
+        ExitOnFailedTest( "TestLogExportImport",
+                          "Exported log doesn't match the original log.",
+                          RESULT_INVALID_DECRYPTION_OUTPUT );
+    }
+
+    // If the first record was made with the same key bytes, then fail.
+    if( IsFilesIdentical( "encrypted.bin", "encryptedA.bin" ) )
+    {
+        ExitOnFailedTest( "TestLogExportImport",
+                          "Key bytes were used twice.",
+                          RESULT_INVALID_DECRYPTION_OUTPUT );
+    }
+
+    // Decrypt the last record and compare it to the plaintext.
+    Test( "./ot7 -d encryptedC.bin -od decrypted.bin -KeyID 123 -silent",
+          RESULT_OK );
+
+    // If the decrypted file doesn't match the plaintext, then fail.
+    if( IsFilesIdentical( "plain.bin", "decrypted.bin" ) == 0 )
+    {
+        ExitOnFailedTest( "TestLogExportImport",
+                          "Decrypted file does not match original plaintext.",
+                          RESULT_INVALID_DECRYPTION_OUTPUT );
+    }
+
+    // Delete the working files and the log files.
+    remove( "plain.bin" );
+    remove( "encrypted.bin" );
+    remove( "encryptedA.bin" );
+    remove( "encryptedB.bin" );
+    remove( "encryptedC.bin" );
+    remove( "decrypted.bin" );
+    remove( "exported.txt" );
+    remove( "test.log" );
+    remove( "test.log.bin" );
+    remove( "old.log" );
+    remove( "old.log.bin" );
+    remove( "import.log" );
+    remove( "import.log.bin" );
+
+    printf( "PASS: TestLogExportImport for file size %s.\n",
+             ConvertIntegerToString64( FileSize ) );
 }
 
 /*------------------------------------------------------------------------------
-| TestEncryptDecryptFiles_EncryptedFileFormatBinary
+| TestLostKeyUsageLog
 |-------------------------------------------------------------------------------
 |
-| PURPOSE: To test encryption and decryption of a range of file sizes using key
-|          file '123.key', producing binary output format for the encrypted
-|          files. 
+| PURPOSE: To test that a key file can't be used after the key usage log is
+|          lost, until the log is restored by importing an exported copy.
 |
-| DESCRIPTION: Other OT7 options are defaults and OT7 user message output is 
-| suppressed with the '-silent' option.
-| 
-| Only returns from this routine if all tests pass, otherwise exiting on the 
-| first failure.
+| DESCRIPTION: A random plaintext file 'plain.bin' is encrypted using a new log
+| file 'lost.log', which also makes the key usage log 'lost.log.bin'. The key
+| usage log is exported to 'lost.txt' and then deleted.
 |
-| See the description of TestEncryptDecryptFile() for details.
+| The text log 'lost.log' then only shows that the key file has been used, so
+| encrypting again should fail with RESULT_KEY_FILE_USED_UP. After importing
+| 'lost.txt', encrypting should work again using key bytes after those used
+| by the first record.
 |
-| EXAMPLE: To test all files sizes from 1 to 3000 bytes, use this call:
+| If the test passes, then the working files are deleted. Otherwise they are
+| left on the disk and this test application exits.
 |
-|   TestEncryptDecryptFiles_EncryptedFileFormatBinary( 1LL, 3000LL, 1LL ); 
+| EXAMPLE: TestLostKeyUsageLog( 3000LL );
 |
-| HISTORY:  
-|    31Dec14 
+| HISTORY:
+|    17Oct26
 ------------------------------------------------------------------------------*/
 void
-TestEncryptDecryptFiles_EncryptedFileFormatBinary( 
-    u64 StartFileSize, 
-    u64 EndFileSize, 
-    u64 SizeIncrement )
+TestLostKeyUsageLog( u64 FileSize )
 {
-    u64 FileSize;
-    
     // Print a dividing line between tests to make reading log files easier.
-    printf( "@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@"
-            "@@@@@@@@@@@@@@@@@@\n" );
-  
-    printf( "TestEncryptDecryptFiles_EncryptedFileFormatBinary for file \n" );
-    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
-    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
-    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
-      
-    // Test the encryption and decryption of all file sizes from the starting
-    // file size to the ending file size, stepping by the given increment.
-    for( FileSize  = StartFileSize; 
-         FileSize <= EndFileSize; 
-         FileSize += SizeIncrement )
+    printf( "**************************************************************"
+            "******************\n" );
+
+    printf( "TestLostKeyUsageLog for file size %s.\n",
+            ConvertIntegerToString64( FileSize ) );
+
+    // Delete any log files left from an earlier test.
+    remove( "lost.log" );
+    remove( "lost.log.bin" );
+
+    // Generate a plaintext file of the given size and filled with pseudo-random
+    // bytes.
+    if( GenerateRandomFile( "plain.bin", FileSize ) != RESULT_OK )
     {
-        // Generate a file of the current size, encrypt it, and decrypt it, 
-        // and compare the results.
-        //
-        // Returns if successful, or application exits with an error code if 
-        // not.
-        TestEncryptDecryptFile( 
-            FileSize,
-            "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -binary -silent",
-            "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 -binary -silent" );
+        ExitOnFailedTest( "TestLostKeyUsageLog",
+                          "Unable to generate plaintext file.",
+                          RESULT_CANT_WRITE_FILE );
     }
-    
-    printf( "PASS: TestEncryptDecryptFiles_EncryptedFileFormatBinary for file \n" );
-    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
-    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
-    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+
+    // Encrypt the plaintext using a new log file.
+    Test( "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -logfile lost.log "
+          "-binary -silent",
+          RESULT_OK );
+
+    // Export the key usage log to text, and then lose it.
+    Test( "./ot7 -logfile lost.log -exportlog lost.txt -silent", RESULT_OK );
+
+    remove( "lost.log.bin" );
+
+    // The key file should now be listed as used up.
+    Test( "./ot7 -e plain.bin -oe encryptedA.bin -KeyID 123 -logfile lost.log "
+          "-binary -silent",
+          RESULT_KEY_FILE_USED_UP );
+
+    // Restore the key usage log from the exported copy.
+    Test( "./ot7 -logfile lost.log -importlog lost.txt -silent", RESULT_OK );
+
+    // The key file should be usable again.
+    Test( "./ot7 -e plain.bin -oe encryptedA.bin -KeyID 123 -logfile lost.log "
+          "-binary -silent",
+          RESULT_OK );
+
+    // If the first record was made with the same key bytes, then fail.
+    if( IsFilesIdentical( "encrypted.bin", "encryptedA.bin" ) )
+    {
+        ExitOnFailedTest( "TestLostKeyUsageLog",
+                          "Key bytes were used twice.",
+                          RESULT_INVALID_DECRYPTION_OUTPUT );
+    }
+
+    // Decrypt the last record and compare it to the plaintext.
+    Test( "./ot7 -d encryptedA.bin -od decrypted.bin -KeyID 123 -silent",
+          RESULT_OK );
+
+    // If the decrypted file doesn't match the plaintext, then fail.
+    if( IsFilesIdentical( "plain.bin", "decrypted.bin" ) == 0 )
+    {
+        ExitOnFailedTest( "TestLostKeyUsageLog",
+                          "Decrypted file does not match original plaintext.",
+                          RESULT_INVALID_DECRYPTION_OUTPUT );
+    }
+
+    // Delete the working files and the log files.
+    remove( "plain.bin" );
+    remove( "encrypted.bin" );
+    remove( "encryptedA.bin" );
+    remove( "decrypted.bin" );
+    remove( "lost.txt" );
+    remove( "lost.log" );
+    remove( "lost.log.bin" );
+
+    printf( "PASS: TestLostKeyUsageLog for file size %s.\n",
+             ConvertIntegerToString64( FileSize ) );
 }
 
 /*------------------------------------------------------------------------------
-| TestEncryptDecryptFiles_NoFileName
+| TestSeekableThreads
 |-------------------------------------------------------------------------------
 |
-| PURPOSE: To test encryption and decryption of a range of file sizes using key
-|          file '123.key', producing an OT7 record without an embedded file 
-|          name.
+| PURPOSE: To test that a seekable OT7 record doesn't depend on the number of
+|          threads used to make it.
 |
-| DESCRIPTION: Other OT7 options are defaults and OT7 user message output is 
-| suppressed with the '-silent' option.
-| 
-| Only returns from this routine if all tests pass, otherwise exiting on the 
-| first failure.
+| DESCRIPTION: A random plaintext file 'plain.bin' is encrypted three times to
+| seekable binary records using 1, 3 and 8 threads and the given chunk size.
+| Each encryption starts with a new log file so the same key bytes are used
+| each time, which means the records should be identical.
 |
-| See the description of TestEncryptDecryptFile() for details.
+| The record made with 8 threads is then decrypted using 3 threads and
+| compared to the plaintext.
 |
-| EXAMPLE: To test all files sizes from 1 to 3000 bytes, use this call:
+| If the test passes, then the working files are deleted. Otherwise they are
+| left on the disk and this test application exits.
 |
-|   TestEncryptDecryptFiles_NoFileName( 1LL, 3000LL, 1LL ); 
+| EXAMPLE: TestSeekableThreads( 1000000LL, 4096 );
 |
-| HISTORY:  
-|    31Dec14 
+| HISTORY:
+|    17Oct26
 ------------------------------------------------------------------------------*/
 void
-TestEncryptDecryptFiles_NoFileName( 
-    u64 StartFileSize, 
-    u64 EndFileSize, 
-    u64 SizeIncrement )
+TestSeekableThreads(
+    u64 FileSize,
+            // Size of the plaintext file to make.
+            //
+    u32 ChunkSize )
+            // Size of the chunks of text in the record.
 {
-    u64 FileSize;
-    
+    u32 ThreadCounts[3] = { 1, 3, 8 };
+    s8  Command[256];
+    s8  FileName[32];
+    u32 i;
+
     // Print a dividing line between tests to make reading log files easier.
-    printf( "@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@"
-            "@@@@@@@@@@@@@@@@@@\n" );
-  
-    printf( "TestEncryptDecryptFiles_NoFileName for file \n" );
-    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
-    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
-    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
-      
-    // Test the encryption and decryption of all file sizes from the starting
-    // file size to the ending file size, stepping by the given increment.
-    for( FileSize  = StartFileSize; 
-         FileSize <= EndFileSize; 
-         FileSize += SizeIncrement )
+    printf( "**************************************************************"
+            "******************\n" );
+
+    printf( "TestSeekableThreads for file size %s ",
+            ConvertIntegerToString64( FileSize ) );
+    printf( "and chunk size %lu.\n", ChunkSize );
+
+    // Generate a plaintext file of the given size and filled with pseudo-random
+    // bytes.
+    if( GenerateRandomFile( "plain.bin", FileSize ) != RESULT_OK )
     {
-        // Generate a file of the current size, encrypt it, and decrypt it, 
-        // and compare the results.
-        //
-        // Returns if successful, or application exits with an error code if 
-        // not.
-        TestEncryptDecryptFile( 
-            FileSize,
-            "./ot7 -e plain.bin -oe encrypted.bin -KeyID 123 -nofilename -silent",
-            "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 -silent" );
+        ExitOnFailedTest( "TestSeekableThreads",
+                          "Unable to generate plaintext file.",
+                          RESULT_CANT_WRITE_FILE );
     }
-    
-    printf( "PASS: TestEncryptDecryptFiles_NoFileName for file \n" );
-    printf( "sizes %s to ", ConvertIntegerToString64( StartFileSize ) );
-    printf( "%s stepping by ", ConvertIntegerToString64( EndFileSize ) );
-    printf( "%s.\n", ConvertIntegerToString64( SizeIncrement ) );
+
+    // Encrypt the plaintext once for each number of threads.
+    for( i = 0; i < 3; i++ )
+    {
+        // Make the name of a new log file for this encryption.
+        sprintf( FileName, "seek%lu.log", ThreadCounts[i] );
+
+        // Delete any log files left from an earlier test.
+        remove( FileName );
+        strcat( FileName, ".bin" );
+        remove( FileName );
+
+        // Make the encryption command for this number of threads.
+        sprintf( Command,
+                 "./ot7 -e plain.bin -oe encrypted%lu.bin -KeyID 123 "
+                 "-seekable -threads %lu -chunk %lu -logfile seek%lu.log "
+                 "-binary -silent",
+                 ThreadCounts[i], ThreadCounts[i], ChunkSize,
+                 ThreadCounts[i] );
+
+        // Encrypt the plaintext.
+        Test( Command, RESULT_OK );
+    }
+
+    // If the records aren't all the same, then fail.
+    if( ( IsFilesIdentical( "encrypted1.bin", "encrypted3.bin" ) == 0 ) ||
+        ( IsFilesIdentical( "encrypted1.bin", "encrypted8.bin" ) == 0 ) )
+    {
+        ExitOnFailedTest( "TestSeekableThreads",
+                          "Records differ for different numbers of threads.",
+                          RESULT_INVALID_DECRYPTION_OUTPUT );
+    }
+
+    // Decrypt one of the records using several threads.
+    Test( "./ot7 -d encrypted8.bin -od decrypted.bin -KeyID 123 -threads 3 "
+          "-silent",
+          RESULT_OK );
+
+    // If the decrypted file doesn't match the plaintext, then fail.
+    if( IsFilesIdentical( "plain.bin", "decrypted.bin" ) == 0 )
+    {
+        ExitOnFailedTest( "TestSeekableThreads",
+                          "Decrypted file does not match original plaintext.",
+                          RESULT_INVALID_DECRYPTION_OUTPUT );
+    }
+
+    // Delete the working files and the log files.
+    for( i = 0; i < 3; i++ )
+    {
+        sprintf( FileName, "encrypted%lu.bin", ThreadCounts[i] );
+        remove( FileName );
+        sprintf( FileName, "seek%lu.log", ThreadCounts[i] );
+        remove( FileName );
+        strcat( FileName, ".bin" );
+        remove( FileName );
+    }
+
+    remove( "plain.bin" );
+    remove( "decrypted.bin" );
+
+    printf( "PASS: TestSeekableThreads for file size %s.\n",
+             ConvertIntegerToString64( FileSize ) );
+}
+
+/*------------------------------------------------------------------------------
+| TestStandardStreamDecryption
+|-------------------------------------------------------------------------------
+|
+| PURPOSE: To test that decryption refuses to use standard input or standard
+|          output.
+|
+| DESCRIPTION: A record is encrypted to standard output with '-oe -', which is
+| supported. Decrypting it with '-d -' should fail with
+| RESULT_INVALID_NAME_OF_FILE_TO_DECRYPT, and decrypting it with '-od -'
+| should fail with RESULT_INVALID_OUTPUT_FILE_NAME, without a file named '-'
+| being made either time. The record is then decrypted normally and compared
+| to the plaintext.
+|
+| If the test passes, then the working files are deleted. Otherwise they are
+| left on the disk and this test application exits.
+|
+| EXAMPLE: TestStandardStreamDecryption();
+|
+| HISTORY:
+|    17Oct26
+------------------------------------------------------------------------------*/
+void
+TestStandardStreamDecryption()
+{
+    // Print a dividing line between tests to make reading log files easier.
+    printf( "**************************************************************"
+            "******************\n" );
+
+    printf( "TestStandardStreamDecryption.\n" );
+
+    // Delete any file named '-' left from an earlier test.
+    remove( "-" );
+
+    // Generate a plaintext file filled with pseudo-random bytes.
+    if( GenerateRandomFile( "plain.bin", 3000LL ) != RESULT_OK )
+    {
+        ExitOnFailedTest( "TestStandardStreamDecryption",
+                          "Unable to generate plaintext file.",
+                          RESULT_CANT_WRITE_FILE );
+    }
+
+    // Encrypt the plaintext to standard output.
+    Test( "./ot7 -e plain.bin -oe - -KeyID 123 -silent > encrypted.bin",
+          RESULT_OK );
+
+    // Decrypting standard input should fail.
+    Test( "./ot7 -d - -od decrypted.bin -KeyID 123 -silent < encrypted.bin",
+          RESULT_INVALID_NAME_OF_FILE_TO_DECRYPT );
+
+    // Decrypting to standard output should fail.
+    Test( "./ot7 -d encrypted.bin -od - -KeyID 123 -silent > decrypted.bin",
+          RESULT_INVALID_OUTPUT_FILE_NAME );
+
+    // If a file named '-' was made, then fail.
+    if( GetFileSizeByName( "-" ) != MAX_VALUE_64BIT )
+    {
+        ExitOnFailedTest( "TestStandardStreamDecryption",
+                          "A file named '-' was made.",
+                          RESULT_INVALID_OUTPUT_FILE_NAME );
+    }
+
+    // Decrypting to a named file should work.
+    Test( "./ot7 -d encrypted.bin -od decrypted.bin -KeyID 123 -silent",
+          RESULT_OK );
+
+    // If the decrypted file doesn't match the plaintext, then fail.
+    if( IsFilesIdentical( "plain.bin", "decrypted.bin" ) == 0 )
+    {
+        ExitOnFailedTest( "TestStandardStreamDecryption",
+                          "Decrypted file does not match original plaintext.",
+                          RESULT_INVALID_DECRYPTION_OUTPUT );
+    }
+
+    // Delete the working files.
+    remove( "plain.bin" );
+    remove( "encrypted.bin" );
+    remove( "decrypted.bin" );
+
+    printf( "PASS: TestStandardStreamDecryption.\n" );
 }
 
 /*------------------------------------------------------------------------------